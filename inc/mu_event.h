@@ -0,0 +1,250 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_event.h
+ * @brief A mu_event pairs a mu_thunk with the time at which it should run.
+ *
+ * mu_event_t objects are the unit of storage for the scheduler's event stores
+ * (the sorted mu_pvec, the timer wheel and the heap).  They are normally
+ * allocated from the scheduler's event pool, but may also be embedded in
+ * caller-owned structures (see mu_sched_at_event()).
+ *
+ * By default an event's timestamp is a full mu_time_abs_t.  Define
+ * MU_SCHED_TICK_EVENTS (for every translation unit, including the
+ * scheduler's) to store it instead as a single MU_SCHED_TICK_BITS-wide count
+ * of MU_SCHED_TICK_NS-nanosecond ticks.  That shrinks each event and reduces
+ * every ordering test to one wrap-safe unsigned subtraction (see
+ * docs/Notes.md).  Timestamps are then truncated to tick resolution, and all
+ * pending events must lie within half the counter range of one another and of
+ * the current time: about 35 minutes with the default 32-bit, 1 us ticks.
+ */
+
+#ifndef MU_EVENT_H
+#define MU_EVENT_H
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h" // For mu_thunk_t definition
+#include "mu_time.h"  // For mu_time_abs_t, mu_time_xxx()
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_SCHED_TICK_BITS
+/** Width of a tick count: 32 or 64. */
+#define MU_SCHED_TICK_BITS 32
+#endif
+
+#ifndef MU_SCHED_TICK_NS
+/** Nanoseconds per tick. */
+#define MU_SCHED_TICK_NS 1000
+#endif
+
+#if MU_SCHED_TICK_BITS == 32
+typedef uint32_t mu_event_tick_t;
+#define MU_EVENT_TICK_HALF ((mu_event_tick_t)0x80000000u)
+#elif MU_SCHED_TICK_BITS == 64
+typedef uint64_t mu_event_tick_t;
+#define MU_EVENT_TICK_HALF ((mu_event_tick_t)0x8000000000000000u)
+#else
+#error "MU_SCHED_TICK_BITS must be 32 or 64"
+#endif
+
+/**
+ * @brief The representation of an event's timestamp.
+ */
+#ifdef MU_SCHED_TICK_EVENTS
+typedef mu_event_tick_t mu_event_time_t;
+#else
+typedef mu_time_abs_t mu_event_time_t;
+#endif
+
+/**
+ * @brief A mu_event is a mu_thunk scheduled to run at a specific time.
+ *
+ * Used internally by the event stores.  The link fields are owned by whichever
+ * store currently holds the event and must not be touched by the user.
+ */
+typedef struct mu_event {
+    // `thunk` stays first: the event pool may reuse the first word of a free
+    // event as its free-list link, so fields that must survive a free (seq,
+    // flags) come later.
+    mu_thunk_t *thunk; ///< Pointer to the thunk to be executed.
+    mu_event_time_t timestamp; ///< The time at which the thunk should run.
+    union {
+        struct {
+            struct mu_event *next;   ///< Forward link for list-based stores.
+            struct mu_event **pprev; ///< Back link for list-based stores.
+        };
+        size_t index; ///< Position in array-based event stores.
+    };
+    mu_time_rel_t period;    ///< Repeat interval, or 0 for a one-shot event.
+    void *args;    ///< Passed to the thunk when it runs, or NULL.
+    uint32_t seq;  ///< Insertion sequence number, breaks timestamp ties.
+    uint8_t flags; ///< Scheduler-private state bits.
+} mu_event_t;
+
+/**
+ * @brief Called for each event by the event stores' visit functions.
+ */
+typedef void (*mu_event_visit_fn)(const mu_event_t *evt, void *ctx);
+
+// *****************************************************************************
+// Public function prototypes
+
+/**
+ * @brief Prepares a caller-owned event node for mu_sched_at_event().
+ */
+static inline void mu_event_init(mu_event_t *evt) {
+    memset(evt, 0, sizeof(*evt));
+}
+
+/**
+ * @brief Converts an absolute time to a (truncated, wrapping) tick count.
+ */
+static inline mu_event_tick_t mu_event_tick_of(mu_time_abs_t t) {
+    uint64_t ns = (uint64_t)t.seconds * 1000000000u + (uint64_t)t.nanoseconds;
+    return (mu_event_tick_t)(ns / MU_SCHED_TICK_NS);
+}
+
+/**
+ * @brief Returns true if tick a comes before tick b, across counter wrap.
+ *
+ * a precedes b if b is less than half the counter range ahead of a.
+ */
+static inline bool mu_event_tick_is_before(mu_event_tick_t a,
+                                           mu_event_tick_t b) {
+    return (mu_event_tick_t)(a - b) >= MU_EVENT_TICK_HALF;
+}
+
+/**
+ * @brief Returns the signed distance a - b in nanoseconds.
+ */
+static inline mu_time_rel_t mu_event_tick_difference(mu_event_tick_t a,
+                                                     mu_event_tick_t b) {
+    if (mu_event_tick_is_before(a, b)) {
+        return -(mu_time_rel_t)(mu_event_tick_t)(b - a) * MU_SCHED_TICK_NS;
+    }
+    return (mu_time_rel_t)(mu_event_tick_t)(a - b) * MU_SCHED_TICK_NS;
+}
+
+/**
+ * @brief Converts an absolute time to the event timestamp representation.
+ */
+static inline mu_event_time_t mu_event_time_of(mu_time_abs_t t) {
+#ifdef MU_SCHED_TICK_EVENTS
+    return mu_event_tick_of(t);
+#else
+    return t;
+#endif
+}
+
+/**
+ * @brief Returns true if event time a comes before event time b.
+ */
+static inline bool mu_event_time_is_before(mu_event_time_t a,
+                                           mu_event_time_t b) {
+#ifdef MU_SCHED_TICK_EVENTS
+    return mu_event_tick_is_before(a, b);
+#else
+    return mu_time_is_before(a, b);
+#endif
+}
+
+/**
+ * @brief Returns the signed distance a - b in nanoseconds.
+ */
+static inline mu_time_rel_t mu_event_time_difference(mu_event_time_t a,
+                                                     mu_event_time_t b) {
+#ifdef MU_SCHED_TICK_EVENTS
+    return mu_event_tick_difference(a, b);
+#else
+    return mu_time_difference(a, b);
+#endif
+}
+
+/**
+ * @brief Returns t offset by dt nanoseconds (truncated to whole ticks).
+ */
+static inline mu_event_time_t mu_event_time_offset(mu_event_time_t t,
+                                                   mu_time_rel_t dt) {
+#ifdef MU_SCHED_TICK_EVENTS
+    return (mu_event_tick_t)(t + (mu_event_tick_t)(dt / MU_SCHED_TICK_NS));
+#else
+    return mu_time_offset(t, dt);
+#endif
+}
+
+/**
+ * @brief Returns true if an event with key (a_time, a_seq) should run before
+ * one with key (b_time, b_seq).
+ *
+ * Events are ordered by timestamp.  Events with equal timestamps are ordered
+ * by insertion sequence number so that ties run first-in, first-out.  The
+ * sequence comparison is wrap-safe (see docs/Notes.md).
+ */
+static inline bool mu_event_key_is_before(mu_event_time_t a_time,
+                                          uint32_t a_seq,
+                                          mu_event_time_t b_time,
+                                          uint32_t b_seq) {
+    if (mu_event_time_is_before(a_time, b_time)) {
+        return true;
+    } else if (mu_event_time_is_before(b_time, a_time)) {
+        return false;
+    }
+    // a precedes b if b is less than 2^31 steps ahead of a.
+    return (uint32_t)(b_seq - a_seq - 1u) < 0x7fffffffu;
+}
+
+/**
+ * @brief Returns true if event a should run before event b.
+ *
+ * See mu_event_key_is_before().
+ */
+static inline bool mu_event_is_before(const mu_event_t *a,
+                                      const mu_event_t *b) {
+    return mu_event_key_is_before(a->timestamp, a->seq, b->timestamp, b->seq);
+}
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MU_EVENT_H */
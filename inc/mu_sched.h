@@ -33,6 +33,14 @@
  *
  * The scheduler requires initialized instances of mu_spsc, mu_pqueue, mu_pvec,
  * and mu_pool modules, with user-provided memory for their backing stores.
+ * As an alternative to the sorted mu_pvec event queue, pending events can be
+ * held in a hierarchical timer wheel (see mu_sched_wheel.h) or a d-ary
+ * min-heap (see mu_sched_heap.h).
+ *
+ * Every function operates on a default scheduler instance.  Applications that
+ * need several schedulers (e.g. one per core or per worker thread) allocate
+ * their own mu_sched_t objects and use the `_ex` variants, which take the
+ * instance as their first argument.  Instances share no state.
  * The scheduler manages *pointers* to mu_thunk_t objects; the user is
  * responsible for the allocation and lifetime of the mu_thunk_t instances
  * themselves (e.g., using static/global variables).
@@ -44,14 +52,20 @@
 // *****************************************************************************
 // Includes
 
-#include "mu_pool.h"   // For mu_pool_t (needed for mu_event_t)
-#include "mu_pqueue.h" // For mu_pqueue_t (stores mu_thunk_t* pointers)
-#include "mu_pvec.h"   // For mu_pvec_t (stores mu_event_t* pointers)
-#include "mu_spsc.h"   // For mu_spsc_t (stores mu_thunk_t*pointers)
+#include "mu_event.h"       // For mu_event_t
+#include "mu_pool.h"        // For mu_pool_t (needed for mu_event_t)
+#include "mu_pqueue.h"      // For mu_pqueue_t (stores mu_thunk_t* pointers)
+#include "mu_pvec.h"        // For mu_pvec_t (stores mu_event_t* pointers)
+#include "mu_sched_edf.h"   // For mu_sched_edf_t (deadline-ordered thunks)
+#include "mu_sched_heap.h"  // For mu_sched_heap_t (indexes mu_event_t)
+#include "mu_sched_stats.h" // For mu_sched_stats_t (if MU_SCHED_STATS)
+#include "mu_sched_wheel.h" // For mu_sched_wheel_t (links mu_event_t)
+#include "mu_spsc.h"        // For mu_spsc_t (stores mu_thunk_t*pointers)
 #include "mu_thunk.h"  // For mu_thunk_t definition
 #include "mu_time.h"   // For mu_time_abs_t, mu_time_rel_t, mu_time_xxx()
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 // *****************************************************************************
 // C++ Compatibility
@@ -63,17 +77,177 @@ extern "C" {
 // *****************************************************************************
 // Public types and definitions
 
+#ifndef MU_SCHED_PRIO_LEVELS
+/**
+ * Number of priority levels that run ahead of the asap_q (1 to 32).
+ */
+#define MU_SCHED_PRIO_LEVELS 8
+#endif
+
+#if MU_SCHED_PRIO_LEVELS < 1 || MU_SCHED_PRIO_LEVELS > 32
+#error "MU_SCHED_PRIO_LEVELS must be between 1 and 32"
+#endif
+
+struct mu_sched_mpsc;  // See mu_sched_mpsc.h
+struct mu_sched_trace; // See mu_sched_trace.h
+
+/**
+ * @brief Identifies one scheduled event so that it can be cancelled.
+ *
+ * Filled in by mu_sched_at_handle() and mu_sched_in_handle().  A handle stays
+ * safe to pass to mu_sched_cancel() after its event has run or been cancelled:
+ * the sequence number detects that the underlying mu_event_t has been recycled.
+ */
+typedef struct {
+    mu_event_t *event; ///< The scheduled event, or NULL.
+    uint32_t seq;      ///< The event's sequence number when it was scheduled.
+} mu_sched_handle_t;
+
+/**
+ * @brief What to do when a thunk becomes ready but the ready queue is full.
+ *
+ * Applies to the asap_q (or the EDF queue, if attached).  Thunks posted from
+ * other threads always wait in the remote queue until there is room.
+ */
+typedef enum {
+    /**
+     * Leave due events in the event store until the ready queue has room.
+     * mu_sched_now() fails.  This is the default.
+     */
+    MU_SCHED_OVERLOAD_DEFER,
+    /** Discard the thunk that does not fit: due events are dropped. */
+    MU_SCHED_OVERLOAD_DROP_NEWEST,
+    /**
+     * Evict the oldest ready thunk to make room.  With an EDF queue attached
+     * this behaves as MU_SCHED_OVERLOAD_DROP_NEWEST.
+     */
+    MU_SCHED_OVERLOAD_DROP_OLDEST,
+} mu_sched_overload_t;
+
+/**
+ * @brief Overload counters and queue high-water marks.
+ *
+ * The high-water marks record the most entries each store has held since
+ * the last reset, which is the figure to size its backing store by.
+ */
+typedef struct {
+    uint32_t rejected;      /**< mu_sched_now*() calls refused: queue full */
+    uint32_t dropped_due;   /**< Due events dropped: ready queue full */
+    uint32_t dropped_ready; /**< Ready thunks evicted by DROP_OLDEST */
+    uint32_t deferred;      /**< Promotion passes stopped by a full queue */
+    size_t ready_hwm;       /**< Most thunks held by the asap_q / EDF queue */
+    size_t event_hwm;       /**< Most events held by the event store */
+    size_t isr_hwm;         /**< Most thunks seen in the interrupt queue */
+    size_t pool_hwm;        /**< Most event wrappers taken from the pool */
+} mu_sched_overload_stats_t;
+
 /**
- * @brief A mu_event is a mu_thunk scheduled to run at a specific time.
+ * @brief A declared run-time budget for one thunk, and how it has held up.
  *
- * Used internally by the event queue. These objects are allocated from a pool.
- * TODO: Consider making mu_event_t a standalone module.
+ * Entries live in a caller-provided table (see mu_sched_set_budget_table()).
  */
 typedef struct {
-    mu_thunk_t *thunk; ///< Pointer to the thunk to be executed.
-    mu_time_abs_t
-        timestamp; ///< The absolute time at which the thunk should run.
-} mu_event_t;
+    const mu_thunk_t *thunk;   /**< The thunk, or NULL for a free entry */
+    mu_time_rel_t budget;      /**< Longest a single run should take */
+    mu_time_rel_t max_runtime; /**< Longest run seen */
+    uint32_t overruns;         /**< Runs that took longer than `budget` */
+} mu_sched_budget_t;
+
+/**
+ * @brief Called after a thunk has run for longer than its budget.
+ *
+ * Runs in scheduler context, between thunks.
+ */
+typedef void (*mu_sched_overrun_fn)(const mu_thunk_t *thunk,
+                                    mu_time_rel_t runtime,
+                                    mu_time_rel_t budget);
+
+/**
+ * @brief A caller-owned node that lets a thunk be queued at most once.
+ *
+ * Typically embedded next to the thunk and initialized once with
+ * mu_sched_once_init().  See mu_sched_now_once().
+ */
+typedef struct {
+    mu_thunk_t *thunk;       /**< The thunk to run */
+    volatile uint8_t queued; /**< Non-zero from posting until taken */
+} mu_sched_once_t;
+
+/**
+ * @brief One pending event, as reported by mu_sched_snapshot().
+ */
+typedef struct {
+    const mu_thunk_t *thunk; /**< The thunk the event will run */
+    mu_time_abs_t timestamp; /**< When it is due */
+    mu_time_rel_t period;    /**< Repeat interval, or 0 for a one-shot */
+} mu_sched_pending_t;
+
+/**
+ * @brief A point-in-time view of the scheduler's queues and event pool.
+ */
+typedef struct {
+    size_t isr_count;      /**< Thunks waiting in the interrupt queue */
+    size_t ready_count;    /**< Thunks in the ready queues */
+    size_t ready_capacity; /**< Capacity of the asap_q / EDF queue plus
+                                any attached priority level queues */
+    size_t event_count;    /**< Events held by the event store */
+    size_t event_capacity; /**< Event store capacity, SIZE_MAX if unbounded */
+    size_t pool_in_use;    /**< Event wrappers taken from the event pool */
+    bool remote_pending;   /**< The remote queue holds thunks */
+    size_t pending_count;  /**< Entries filled in the `pending` array */
+    mu_sched_overload_stats_t overload; /**< Counters and high-water marks */
+} mu_sched_snapshot_t;
+
+/**
+ * @brief A scheduler instance.
+ *
+ * Contains pointers to the user-provided and already initialized queue and pool
+ * instances. The user is responsible for declaring and initializing the actual
+ * queue and pool structures and their backing memory, and passing pointers to
+ * them during scheduler initialization.
+ *
+ * The user allocates mu_sched_t objects (typically as static variables) but
+ * must treat their contents as private to mu_sched.
+ */
+typedef struct mu_sched_t {
+    mu_spsc_t *interrupt_q; /**< Interrupt queue of mu_thunk_t* pointers */
+    mu_pqueue_t *asap_q;    /**< ASAP queue of mu_thunk_t* pointers */
+    mu_sched_edf_t *edf_q;  /**< Optional EDF queue, used instead of asap_q */
+    mu_pqueue_t *prio_q[MU_SCHED_PRIO_LEVELS]; /**< Optional priority levels */
+    uint32_t prio_ready; /**< Bit n is set while prio_q[n] may be non-empty */
+    mu_sched_overload_t overload_policy; /**< Full ready queue behaviour */
+    mu_sched_overload_stats_t overload;  /**< Drop counters, high-water marks */
+    bool lazy_promotion; /**< Run due events in place, not via asap_q */
+    mu_pvec_t *event_q;     /**< Event queue of mu_event_t* pointers */
+    mu_sched_wheel_t *event_wheel; /**< Timer wheel, used instead of event_q */
+    mu_sched_heap_t *event_heap;   /**< d-ary heap, used instead of event_q */
+    mu_pool_t *event_pool;  /**< Pool for mu_event_t wrappers, or NULL */
+    mu_thunk_t *idle_thunk; /**< Idle thunk to run when queues empty */
+    mu_time_abs_t (*get_time)(void); /**< Function to fetch current time */
+    mu_time_abs_t sim_time;          /**< Virtual time in simulation mode */
+    bool simulated;                  /**< True in simulation mode */
+    mu_time_abs_t clock_cache;       /**< Clock reading shared by a pass */
+    bool clock_cached;               /**< True while clock_cache is valid */
+    bool coarse_clock;               /**< Hold clock_cache between passes */
+    mu_thunk_t *current_thunk;       /**< The thunk currently being executed */
+    struct mu_sched_mpsc *remote_q;  /**< Optional cross-thread queue */
+    mu_sched_budget_t *budgets;      /**< Optional run-time budget table */
+    size_t budget_mask;              /**< Budget table capacity - 1 */
+    mu_sched_budget_t *run_budget;   /**< Budget of the running thunk */
+    mu_time_abs_t run_start;         /**< When the budgeted run started */
+    mu_sched_overrun_fn overrun_fn;  /**< Optional overrun callback */
+    volatile uint32_t isr_posts;     /**< Interrupt queue puts, ever */
+    uint32_t isr_takes;              /**< Interrupt queue gets, ever */
+    size_t pool_in_use;              /**< Event wrappers taken from the pool */
+    uint32_t event_seq; /**< Sequence number for the next scheduled event */
+    bool initialized;   /**< True once mu_sched_init*() has succeeded */
+#ifdef MU_SCHED_STATS
+    mu_sched_stats_t stats; /**< Per-thunk latency and runtime statistics */
+#endif
+#ifdef MU_SCHED_TRACE
+    struct mu_sched_trace *trace; /**< Trace ring, or NULL */
+#endif
+} mu_sched_t;
 
 // *****************************************************************************
 // Public function prototypes
@@ -93,14 +267,56 @@ typedef struct {
  * @param event_q Pointer to the initialized mu_pvec_t instance for the event
  * queue (stores mu_event_t*). Must not be NULL.
  * @param event_pool Pointer to the initialized mu_pool_t instance for
- * mu_event_t objects. Must not be NULL. Item size should be
- * sizeof(mu_event_t).
+ * mu_event_t objects, or NULL if all timed events use caller-owned nodes
+ * (see mu_sched_at_event()). Item size should be sizeof(mu_event_t).
  * @return true on success or falseL on failure
  * (e.g., invalid parameters).
  */
 bool mu_sched_init(mu_spsc_t *interrupt_q, mu_pqueue_t *asap_q,
                    mu_pvec_t *event_q, mu_pool_t *event_pool);
 
+/**
+ * @brief Initializes the scheduler instance with a timer wheel event store.
+ *
+ * Identical to mu_sched_init(), except that pending events are held in a
+ * hierarchical timer wheel rather than a sorted mu_pvec, making mu_sched_at()
+ * and event expiry O(1) amortized.  The number of pending events is bounded
+ * only by the size of the event pool.
+ *
+ * @param interrupt_q Pointer to the initialized mu_spsc_t instance for the
+ * interrupt queue (stores mu_thunk_t*). Must not be NULL.
+ * @param asap_q Pointer to the initialized mu_pqueue_t instance for the
+ * asap_q (stores mu_thunk_t*). Must not be NULL.
+ * @param event_wheel Pointer to a mu_sched_wheel_t initialized with
+ * mu_sched_wheel_init(). Must not be NULL.
+ * @param event_pool Pointer to the initialized mu_pool_t instance for
+ * mu_event_t objects, or NULL if all timed events use caller-owned nodes
+ * (see mu_sched_at_event()). Item size should be sizeof(mu_event_t).
+ * @return true on success or false on failure (e.g., invalid parameters).
+ */
+bool mu_sched_init_wheel(mu_spsc_t *interrupt_q, mu_pqueue_t *asap_q,
+                         mu_sched_wheel_t *event_wheel, mu_pool_t *event_pool);
+
+/**
+ * @brief Initializes the scheduler instance with a heap event store.
+ *
+ * Identical to mu_sched_init(), except that pending events are held in a
+ * d-ary min-heap (see mu_sched_heap.h), making mu_sched_at(), event expiry
+ * and mu_sched_cancel() O(log n) with full timestamp resolution.
+ *
+ * @param interrupt_q Pointer to the initialized mu_spsc_t instance for the
+ * interrupt queue (stores mu_thunk_t*). Must not be NULL.
+ * @param asap_q Pointer to the initialized mu_pqueue_t instance for the
+ * asap_q (stores mu_thunk_t*). Must not be NULL.
+ * @param event_heap Pointer to a mu_sched_heap_t initialized with
+ * mu_sched_heap_init(). Must not be NULL.
+ * @param event_pool Pointer to the initialized mu_pool_t instance for
+ * mu_event_t objects, or NULL if all timed events use caller-owned nodes.
+ * @return true on success or false on failure (e.g., invalid parameters).
+ */
+bool mu_sched_init_heap(mu_spsc_t *interrupt_q, mu_pqueue_t *asap_q,
+                        mu_sched_heap_t *event_heap, mu_pool_t *event_pool);
+
 /**
  * @brief Schedules a thunk to run as soon as possible.
  *
@@ -110,11 +326,77 @@ bool mu_sched_init(mu_spsc_t *interrupt_q, mu_pqueue_t *asap_q,
  * be called from thunk context.
  *
  * @param thunk Pointer to the thunk to schedule. Must not be NULL.
- * @return true on success, false if the asap_q is full or invalid
- * scheduler.
+ * @return true on success, false if the asap_q is full (see
+ * mu_sched_set_overload_policy()) or invalid scheduler.
  */
 bool mu_sched_now(mu_thunk_t *thunk);
 
+/**
+ * @brief Schedules a thunk to run as soon as possible, ranked by deadline.
+ *
+ * With an EDF queue attached (see mu_sched_set_edf_queue()), the thunk runs
+ * ahead of every ready thunk with a later deadline.  Without one, this is the
+ * same as mu_sched_now() and `deadline` is ignored.
+ *
+ * @param thunk Pointer to the thunk to schedule. Must not be NULL.
+ * @param deadline The time by which the thunk should run.
+ * @return true on success, false if the ready queue is full or invalid
+ * scheduler.
+ */
+bool mu_sched_now_deadline(mu_thunk_t *thunk, mu_time_abs_t deadline);
+
+/**
+ * @brief Schedules a thunk to run as soon as possible with an argument.
+ *
+ * Like mu_sched_now(), but when the thunk runs it receives `args` as its
+ * second parameter instead of NULL.  The pair is carried in one wrapper from
+ * the event pool, so no per-message context object is needed; `args` itself
+ * is passed through untouched.
+ *
+ * @param thunk Pointer to the thunk to schedule. Must not be NULL.
+ * @param args Argument for this run.  NULL is the same as mu_sched_now().
+ * @return true on success, false if the ready queue or event pool is full or
+ * invalid scheduler.
+ */
+bool mu_sched_now_args(mu_thunk_t *thunk, void *args);
+
+/**
+ * @brief Prepares a once node for `thunk`.
+ *
+ * @return `once`, or NULL if either parameter is NULL.
+ */
+mu_sched_once_t *mu_sched_once_init(mu_sched_once_t *once, mu_thunk_t *thunk);
+
+/**
+ * @brief Schedules a once node's thunk to run as soon as possible, unless it
+ * is already queued.
+ *
+ * Posting a node that is still waiting to run is an O(1) no-op, so bursts of
+ * notifications for the same thunk cost one run.  The node counts as queued
+ * until the scheduler takes its thunk, so a post made while the thunk runs
+ * (including by the thunk itself) queues it again.  Nodes posted with
+ * mu_sched_from_isr_once() are covered alike.
+ *
+ * @param once An initialized node.  Must not be NULL.
+ * @return true if the thunk was queued or already was, false if the ready
+ * queue is full or invalid parameters or scheduler.
+ */
+bool mu_sched_now_once(mu_sched_once_t *once);
+
+/**
+ * @brief Schedules a batch of thunks to run as soon as possible.
+ *
+ * Equivalent to calling mu_sched_now() on each thunk in order, except that
+ * the batch is queued whole or not at all: if the ready queue cannot hold
+ * every thunk, none is queued.  The overload policy does not apply.
+ *
+ * @param thunks Array of `n` thunk pointers, none of them NULL.
+ * @param n Number of thunks in the batch.
+ * @return true on success, false if the ready queue lacks room, invalid
+ * parameters or invalid scheduler.
+ */
+bool mu_sched_now_many(mu_thunk_t *const *thunks, size_t n);
+
 /**
  * @brief Schedules a thunk to run at a specific absolute time.
  *
@@ -132,6 +414,40 @@ bool mu_sched_now(mu_thunk_t *thunk);
  */
 bool mu_sched_at(mu_thunk_t *thunk, mu_time_abs_t timestamp);
 
+/**
+ * @brief Schedules a thunk to run at an absolute time with an argument.
+ *
+ * Like mu_sched_at(), but the thunk receives `args` when it runs.  The
+ * argument is stored in the event wrapper, which then moves to the ready
+ * queue as is when the event falls due.
+ *
+ * @param thunk Pointer to the thunk to schedule. Must not be NULL.
+ * @param timestamp The absolute time at which the thunk should run.
+ * @param args Argument for this run.  NULL is the same as mu_sched_at().
+ * @return true on success, false if the event queue is full, event pool is
+ * full, or invalid scheduler.
+ */
+bool mu_sched_at_args(mu_thunk_t *thunk, mu_time_abs_t timestamp, void *args);
+
+/**
+ * @brief Schedules a batch of thunks, each at its own absolute time.
+ *
+ * Equivalent to calling mu_sched_at(thunks[i], timestamps[i]) for each i in
+ * order (thunks with equal timestamps run in array order), but the wrappers
+ * are reserved from the event pool up front and the batch is scheduled whole
+ * or not at all.  The batch is sorted once and merged into the event store:
+ * with the sorted mu_pvec that is a single pass over the queue rather than a
+ * search per event.
+ *
+ * @param thunks Array of `n` thunk pointers, none of them NULL.
+ * @param timestamps Array of `n` absolute times.
+ * @param n Number of events in the batch.
+ * @return true on success, false if the event pool or event store lacks
+ * room, invalid parameters or invalid scheduler.
+ */
+bool mu_sched_at_many(mu_thunk_t *const *thunks,
+                      const mu_time_abs_t *timestamps, size_t n);
+
 /**
  * @brief Schedules a thunk to run after a given delay.
  *
@@ -147,6 +463,153 @@ bool mu_sched_at(mu_thunk_t *thunk, mu_time_abs_t timestamp);
  */
 bool mu_sched_in(mu_thunk_t *thunk, mu_time_rel_t delay);
 
+/**
+ * @brief Schedules a thunk to run at a specific time and returns a handle.
+ *
+ * Identical to mu_sched_at(), but on success fills `handle` so the event can
+ * later be cancelled with mu_sched_cancel().
+ *
+ * @param thunk Pointer to the thunk to schedule. Must not be NULL.
+ * @param timestamp The absolute time at which the thunk should run.
+ * @param handle Receives the event's handle. May be NULL.
+ * @return true on success, false if the event queue is full, event
+ * pool is full, or invalid scheduler.
+ */
+bool mu_sched_at_handle(mu_thunk_t *thunk, mu_time_abs_t timestamp,
+                        mu_sched_handle_t *handle);
+
+/**
+ * @brief Schedules a thunk to run after a given delay and returns a handle.
+ *
+ * Identical to mu_sched_in(), but on success fills `handle` so the event can
+ * later be cancelled with mu_sched_cancel().
+ *
+ * @param thunk Pointer to the thunk to schedule. Must not be NULL.
+ * @param delay The relative time at which the thunk should run.
+ * @param handle Receives the event's handle. May be NULL.
+ * @return true on success, false if the event queue is full, event
+ * pool is full, or invalid scheduler.
+ */
+bool mu_sched_in_handle(mu_thunk_t *thunk, mu_time_rel_t delay,
+                        mu_sched_handle_t *handle);
+
+/**
+ * @brief Schedules a thunk to run after a delay, allowing it to run late.
+ *
+ * The thunk runs no earlier than `delay` and no later than `delay + slack`
+ * from now.  Within that window the scheduler picks a time shared with other
+ * timers so that they are promoted together and the system wakes up fewer
+ * times: the soonest pending event's time if it falls in the window, else
+ * the window's first multiple of the largest power of two nanoseconds not
+ * exceeding `slack`.  Independent timers with similar slack thereby line up
+ * on the same boundaries.
+ *
+ * @param thunk Pointer to the thunk to schedule. Must not be NULL.
+ * @param delay The earliest time, relative to now, at which to run.
+ * @param slack How much later than that the thunk may run.  0 behaves like
+ * mu_sched_in().
+ * @param handle Receives the event's handle. May be NULL.
+ * @return true on success, false if the event queue is full, event
+ * pool is full, or invalid scheduler.
+ */
+bool mu_sched_in_slack(mu_thunk_t *thunk, mu_time_rel_t delay,
+                       mu_time_rel_t slack, mu_sched_handle_t *handle);
+
+/**
+ * @brief Schedules a thunk to run repeatedly, every `period`.
+ *
+ * The first run is due one period from now.  A single mu_event_t is allocated
+ * up front and re-inserted into the event store each time it falls due, so
+ * later periods cost no pool traffic.  Each deadline is computed from the
+ * previous deadline rather than from the time the thunk actually ran, so the
+ * schedule does not drift.  If the scheduler falls more than a period behind,
+ * the missed deadlines are skipped rather than run back to back, keeping the
+ * original phase.
+ *
+ * The thunk keeps running until the event is cancelled with mu_sched_cancel()
+ * or removed with mu_sched_delete_thunk_events().
+ *
+ * @param thunk Pointer to the thunk to schedule. Must not be NULL.
+ * @param period The interval between runs.  Must be greater than zero.
+ * @return true on success, false if the event queue is full, event
+ * pool is full, or invalid arguments or scheduler.
+ */
+bool mu_sched_every(mu_thunk_t *thunk, mu_time_rel_t period);
+
+/**
+ * @brief Schedules a repeating thunk and returns a handle.
+ *
+ * Identical to mu_sched_every(), but on success fills `handle` so the
+ * repetition can be stopped with mu_sched_cancel().
+ *
+ * @param thunk Pointer to the thunk to schedule. Must not be NULL.
+ * @param period The interval between runs.  Must be greater than zero.
+ * @param handle Receives the event's handle. May be NULL.
+ * @return true on success, false otherwise (see mu_sched_every()).
+ */
+bool mu_sched_every_handle(mu_thunk_t *thunk, mu_time_rel_t period,
+                           mu_sched_handle_t *handle);
+
+/**
+ * @brief Schedules a thunk at a specific time using a caller-owned event node.
+ *
+ * Intrusive alternative to mu_sched_at(): instead of allocating a wrapper
+ * from the event pool, the scheduler links `evt` into the event store
+ * directly.  The node is typically embedded next to the thunk, e.g.
+ *
+ *     typedef struct {
+ *         mu_thunk_t thunk;
+ *         mu_event_t timer;
+ *         ...
+ *     } my_task_t;
+ *
+ * Initialize the node once with mu_event_init() before first use.  While the
+ * node is scheduled it belongs to the scheduler and must stay valid.  Calling
+ * this again on a node that is still scheduled re-arms it at the new time.
+ *
+ * @param evt The caller-owned node. Must not be NULL.
+ * @param thunk Pointer to the thunk to schedule. Must not be NULL.
+ * @param timestamp The absolute time at which the thunk should run.
+ * @return true on success, false if the event queue is full or invalid
+ * arguments or scheduler.
+ */
+bool mu_sched_at_event(mu_event_t *evt, mu_thunk_t *thunk,
+                       mu_time_abs_t timestamp);
+
+/**
+ * @brief Schedules a thunk after a delay using a caller-owned event node.
+ *
+ * See mu_sched_at_event().
+ */
+bool mu_sched_in_event(mu_event_t *evt, mu_thunk_t *thunk,
+                       mu_time_rel_t delay);
+
+/**
+ * @brief Cancels a caller-owned event node scheduled with
+ * mu_sched_at_event() or mu_sched_in_event().
+ *
+ * On return the node is no longer referenced by the scheduler and may be
+ * reused or released.
+ *
+ * @return true if the node was scheduled, false otherwise.
+ */
+bool mu_sched_cancel_event(mu_event_t *evt);
+
+/**
+ * @brief Cancels a pending event.
+ *
+ * With the timer wheel or heap event store the event is unlinked and returned
+ * to the event pool immediately, in O(1) or O(log n) respectively.  With the
+ * mu_pvec event queue the event is marked cancelled in O(1) and
+ * mu_sched_step() discards it when it reaches the head of the queue.
+ *
+ * @param handle A handle filled by mu_sched_at_handle() or
+ * mu_sched_in_handle().  It is cleared on return.
+ * @return true if a pending event was cancelled, false if the event has
+ * already run or been cancelled, or on invalid parameters.
+ */
+bool mu_sched_cancel(mu_sched_handle_t *handle);
+
 /**
  * @brief Schedules a thunk to run from an interrupt context.
  *
@@ -161,6 +624,151 @@ bool mu_sched_in(mu_thunk_t *thunk, mu_time_rel_t delay);
  */
 bool mu_sched_from_isr(mu_thunk_t *thunk);
 
+/**
+ * @brief Schedules a thunk with an argument from an interrupt context.
+ *
+ * The interrupt queue holds bare thunk pointers, so this posts through the
+ * remote queue instead, whose slots carry the argument next to the thunk.
+ * Posting is wait-free, and `args` (e.g. a DMA buffer pointer) reaches the
+ * thunk without being copied.
+ *
+ * This differs from mu_sched_from_isr() in two ways:
+ * - It requires a remote queue (see mu_sched_set_remote_queue()) and an event
+ *   pool, which supplies the wrapper that holds `args` once the scheduler
+ *   drains the remote queue.  Without either it fails.
+ * - The thunk does not run ahead of other ready thunks.  It runs like one
+ *   from mu_sched_post_remote(): after every thunk in the interrupt queue,
+ *   including those posted later with mu_sched_from_isr(), and behind thunks
+ *   already ready when the remote queue is drained.
+ *
+ * @param thunk Pointer to the thunk to schedule. Must not be NULL.
+ * @param args Argument passed to the thunk when it runs.
+ * @return true on success, false if the remote queue is full, none is
+ * attached, the scheduler has no event pool, or invalid scheduler.
+ */
+bool mu_sched_from_isr_args(mu_thunk_t *thunk, void *args);
+
+/**
+ * @brief Schedules a once node's thunk from an interrupt context, unless it
+ * is already queued.
+ *
+ * Like mu_sched_from_isr(), but a node that is still queued, whether from
+ * here or from mu_sched_now_once(), is left as it is.
+ *
+ * @param once An initialized node.  Must not be NULL.
+ * @return true if the thunk was queued or already was, false if the
+ * interrupt queue is full or invalid parameters.
+ */
+bool mu_sched_from_isr_once(mu_sched_once_t *once);
+
+/**
+ * @brief Schedules a thunk to run as soon as possible at a priority level.
+ *
+ * Ready thunks at a higher level always run before those at a lower level,
+ * and every level runs before the asap_q (but after the interrupt queue).
+ * Thunks at the same level run first-in, first-out.  The level's queue must
+ * have been attached with mu_sched_set_prio_queue().
+ *
+ * @param thunk Pointer to the thunk to schedule. Must not be NULL.
+ * @param level Priority level, 0 to MU_SCHED_PRIO_LEVELS - 1.
+ * @return true on success, false if the level is out of range, has no queue
+ * or its queue is full, or invalid scheduler.
+ */
+bool mu_sched_now_prio(mu_thunk_t *thunk, unsigned level);
+
+/**
+ * @brief Attaches the ready queue for one priority level.
+ *
+ * mu_sched_step() finds the highest non-empty level with one
+ * count-leading-zeros on an occupancy bitmap, so unused levels cost nothing.
+ * Passing NULL detaches the level.
+ *
+ * @param level Priority level, 0 to MU_SCHED_PRIO_LEVELS - 1.
+ * @param prio_q Pointer to an initialized mu_pqueue_t (stores mu_thunk_t*),
+ * or NULL.
+ * @return true on success, false if the level is out of range or invalid
+ * scheduler.
+ */
+bool mu_sched_set_prio_queue(unsigned level, mu_pqueue_t *prio_q);
+
+/**
+ * @brief Sets what happens when the ready queue is full.
+ *
+ * @param policy One of the mu_sched_overload_t values.
+ */
+void mu_sched_set_overload_policy(mu_sched_overload_t policy);
+
+/**
+ * @brief Returns the overload counters and queue high-water marks.
+ *
+ * @return A pointer to the live counters, or NULL if the scheduler is not
+ * initialized.
+ */
+const mu_sched_overload_stats_t *mu_sched_overload_stats(void);
+
+/**
+ * @brief Clears the overload counters and high-water marks.
+ */
+void mu_sched_overload_stats_reset(void);
+
+/**
+ * @brief Selects lazy promotion of due events.
+ *
+ * By default every mu_sched_step() first moves all due events into the ready
+ * queue.  With lazy promotion enabled, due events stay in the event store and
+ * a step runs the earliest one in place once the ready queue is empty, so a
+ * burst of timers never overflows the asap_q.  With an EDF queue attached,
+ * a due event runs ahead of ready thunks whose deadlines are later than its
+ * scheduled time.
+ *
+ * @note Thunks that keep re-queueing themselves with mu_sched_now() will hold
+ * off due events while lazy promotion is enabled.
+ *
+ * @param enabled true to run due events in place, false to promote them.
+ */
+void mu_sched_set_lazy_promotion(bool enabled);
+
+/**
+ * @brief Attaches an earliest-deadline-first queue for ready thunks.
+ *
+ * Once attached, ready thunks are queued on `edf_q` instead of the asap_q,
+ * and mu_sched_step() always runs the one with the earliest deadline.  A due
+ * event's deadline is its scheduled time; a thunk from mu_sched_now() or
+ * another thread gets the time it was queued.  Thunks already in the asap_q
+ * run once the EDF queue is empty.  Passing NULL detaches the queue.
+ *
+ * @param edf_q Pointer to a queue initialized with mu_sched_edf_init(), or
+ * NULL.
+ */
+void mu_sched_set_edf_queue(mu_sched_edf_t *edf_q);
+
+/**
+ * @brief Attaches a lock-free queue for posting thunks from other threads.
+ *
+ * Once attached, mu_sched_step() drains the queue into the asap_q right after
+ * checking the interrupt queue, moving as many thunks as the asap_q can hold.
+ * A thunk posted with an argument takes a wrapper from the event pool as it
+ * moves, so draining also pauses while the pool is empty.  Attach the queue
+ * before any other thread starts posting; passing NULL detaches it.
+ *
+ * @param remote_q Pointer to a queue initialized with mu_sched_mpsc_init(),
+ * or NULL.
+ */
+void mu_sched_set_remote_queue(struct mu_sched_mpsc *remote_q);
+
+/**
+ * @brief Schedules a thunk from another thread or core.
+ *
+ * Safe to call concurrently from any number of threads, and wait-free: it
+ * never blocks on the scheduler thread or on other posting threads.  The
+ * thunk runs on the scheduler's thread as if passed to mu_sched_now().
+ *
+ * @param thunk Pointer to the thunk to schedule. Must not be NULL.
+ * @return true on success, false if the remote queue is full, none is
+ * attached, or the scheduler is not initialized.
+ */
+bool mu_sched_post_remote(mu_thunk_t *thunk);
+
 /**
  * @brief Remove all events associated with a thunk from the event_queue.
  *
@@ -195,6 +803,54 @@ void mu_sched_set_idle_thunk(mu_thunk_t *idle_thunk);
  */
 void mu_sched_set_time_fn(mu_time_abs_t (*fn)(void));
 
+/**
+ * @brief Selects coarse clock mode.
+ *
+ * Each mu_sched_step() and mu_sched_step_n() reads the time source once and
+ * shares that reading across its own bookkeeping; by default the cache is
+ * dropped before a thunk runs, so thunks see the live clock.  In coarse mode
+ * the pass's reading is kept until the next pass (or mu_sched_idle_timeout())
+ * begins, so mu_sched_current_time(), mu_sched_in() and friends return it
+ * without touching the time source.  With MU_SCHED_STATS the reading also
+ * advances after every thunk, where statistics read the clock anyway.
+ *
+ * @param enabled true to refresh the clock only at pass boundaries.
+ */
+void mu_sched_set_coarse_clock(bool enabled);
+
+/**
+ * @brief Switches the scheduler to simulated time, starting at `start`.
+ *
+ * In simulation mode the scheduler keeps its own virtual clock instead of
+ * calling the time source, and whenever nothing is ready, mu_sched_step()
+ * and mu_sched_step_n() advance the clock straight to the next event
+ * deadline instead of idling.  Hours of timer workload then run in
+ * milliseconds, and a given sequence of calls always produces the same
+ * schedule.  mu_sched_current_time() reports the virtual time.
+ */
+void mu_sched_sim_start(mu_time_abs_t start);
+
+/**
+ * @brief Leaves simulation mode and returns to the time source.
+ */
+void mu_sched_sim_stop(void);
+
+/**
+ * @brief Moves virtual time forward by `dt` in simulation mode.
+ */
+void mu_sched_sim_advance(mu_time_rel_t dt);
+
+/**
+ * @brief Runs simulated time forward to `end`.
+ *
+ * Runs every thunk that becomes ready up to and including `end`, jumping
+ * between event deadlines, then leaves the virtual clock at `end`.  Does not
+ * run the idle thunk.  Does nothing unless in simulation mode.
+ *
+ * @return The number of thunks run.
+ */
+size_t mu_sched_sim_run_until(mu_time_abs_t end);
+
 /**
  * @brief Executes one scheduling pass.
  *
@@ -204,6 +860,65 @@ void mu_sched_set_time_fn(mu_time_abs_t (*fn)(void));
  */
 void mu_sched_step(void);
 
+/**
+ * @brief Executes up to `max_thunks` thunks in a single batch.
+ *
+ * Reads the clock once, promotes every event due at that time into the asap
+ * queue, then runs thunks in a tight loop, always preferring the interrupt
+ * queue over the asap queue.  Events held back by a full asap queue are
+ * promoted as the queue drains.  Runs the idle thunk if nothing else was
+ * runnable.  Returns immediately if called from within a thunk.
+ *
+ * @param max_thunks Maximum number of thunks to run (the idle thunk does not
+ * count).
+ * @return The number of thunks run, excluding the idle thunk.
+ */
+size_t mu_sched_step_n(size_t max_thunks);
+
+/**
+ * @brief Removes the next runnable thunk without running it.
+ *
+ * Applies the same priority order as mu_sched_step() (interrupt queue, then
+ * thunks posted from other threads and due events via the asap_q) but hands
+ * the thunk to the caller instead of running it.  Together with mu_sched_run()
+ * this lets an executor decide where a ready thunk runs.  The idle thunk is
+ * never returned.
+ *
+ * @param thunk Receives the thunk. Must not be NULL.
+ * @return true if a thunk was taken, false if none is runnable.
+ */
+bool mu_sched_take_ready(mu_thunk_t **thunk);
+
+/**
+ * @brief Like mu_sched_take_ready(), but also returns the thunk's argument.
+ *
+ * Executors that may see thunks scheduled with an argument (see
+ * mu_sched_now_args()) must use this and mu_sched_run_args(); plain
+ * mu_sched_take_ready() discards the argument.
+ *
+ * @param thunk Receives the thunk. Must not be NULL.
+ * @param args Receives its argument, or NULL if it has none.
+ * @return true if a thunk was taken, false if none is runnable.
+ */
+bool mu_sched_take_ready_args(mu_thunk_t **thunk, void **args);
+
+/**
+ * @brief Runs a thunk as the scheduler's current thunk.
+ *
+ * Does nothing if the scheduler is already running a thunk.
+ *
+ * @param thunk The thunk to run, typically from mu_sched_take_ready().
+ */
+void mu_sched_run(mu_thunk_t *thunk);
+
+/**
+ * @brief Runs a thunk with an argument as the scheduler's current thunk.
+ *
+ * @param thunk The thunk to run, typically from mu_sched_take_ready_args().
+ * @param args The argument passed to the thunk.
+ */
+void mu_sched_run_args(mu_thunk_t *thunk, void *args);
+
 /**
  * @brief Checks if there are any thunks ready to run in the interrupt or
  * asap_qs.
@@ -211,11 +926,60 @@ void mu_sched_step(void);
  * This excludes thunks still pending in the event queue. Useful for deciding
  * whether the system can enter a low-power sleep mode.
  *
- * @return true if there are thunks in the interrupt or asap_q, false
- * otherwise.
+ * @return true if there are thunks in the remote queue or any ready queue
+ * (priority levels, EDF queue or asap_q), false otherwise.
  */
 bool mu_sched_has_runnable_thunk(void);
 
+/**
+ * @brief Takes a snapshot of the scheduler's queues and event pool.
+ *
+ * Fills `snap` with the current depth of every queue, the pool usage and a
+ * copy of the overload counters and high-water marks, and `pending` with the
+ * soonest `max_pending` live events, soonest first.  Nothing is modified:
+ * the event store is not advanced and no thunk is promoted.  Finding the
+ * pending events costs O(n * max_pending) for n held events, so this is
+ * meant for debugging and capacity planning, not for the run loop.
+ *
+ * The event count includes pvec tombstones; `pending` does not.  The
+ * interrupt queue count may already be stale when this returns.
+ *
+ * @param snap Receives the snapshot.  Must not be NULL.
+ * @param pending Receives up to `max_pending` events.  May be NULL if
+ * `max_pending` is 0.
+ * @param max_pending Number of entries in `pending`.
+ * @return true on success, false on invalid parameters or scheduler.
+ */
+bool mu_sched_snapshot(mu_sched_snapshot_t *snap, mu_sched_pending_t *pending,
+                       size_t max_pending);
+
+/**
+ * @brief Reports when the earliest pending event is due.
+ *
+ * Considers only events still held by the event store (not thunks already in
+ * the interrupt or asap queues).  Cancelled events are ignored.
+ *
+ * @param out Receives the timestamp of the earliest pending event.
+ * @return true if there is a pending event, false if there is none, `out` is
+ * NULL, or the scheduler is not initialized.
+ */
+bool mu_sched_next_deadline(mu_time_abs_t *out);
+
+/**
+ * @brief Computes how long a tickless idle hook may sleep.
+ *
+ * Intended for the idle thunk: program a wake-up timer for `*timeout` and
+ * sleep.  Any interrupt that calls mu_sched_from_isr() should also end the
+ * sleep.
+ *
+ * @param timeout Receives the time until the earliest pending event, or zero
+ * if a thunk is already runnable or an event is overdue.
+ * @return true if `timeout` was set, false if there is nothing to wait for
+ * (sleep until the next interrupt), `timeout` is NULL, or the scheduler is not
+ * initialized.
+ */
+bool mu_sched_idle_timeout(mu_time_rel_t *timeout);
+
 /**
  * @brief Gets the thunk (thunk) currently being executed by the scheduler.
  *
@@ -229,6 +993,56 @@ bool mu_sched_has_runnable_thunk(void);
  */
 const mu_thunk_t *mu_sched_current_thunk(void);
 
+/**
+ * @brief Attaches a table for per-thunk run-time budgets.
+ *
+ * Every run of a thunk with a budget (see mu_sched_set_budget()) is timed
+ * against the live clock, even in coarse clock mode; runs that exceed the
+ * budget are counted in the thunk's entry and reported to the overrun
+ * callback.  The scheduler cannot stop a thunk: budgets only make overruns
+ * visible, and let the thunk itself split its work with
+ * mu_sched_should_yield().  Thunks without a budget are not timed.
+ * Attaching clears the table; passing NULL detaches it.
+ *
+ * @param table Backing store of `capacity` entries, or NULL.
+ * @param capacity Number of entries.  Must be a power of two.
+ * @return true on success, false if `capacity` is not a power of two or
+ * invalid scheduler.
+ */
+bool mu_sched_set_budget_table(mu_sched_budget_t *table, size_t capacity);
+
+/**
+ * @brief Declares how long one run of `thunk` should take at most.
+ *
+ * @param thunk The thunk.  Must not be NULL.
+ * @param budget Longest acceptable run.  Must be positive.
+ * @return true on success, false if no table is attached, the table is full
+ * or invalid parameters.
+ */
+bool mu_sched_set_budget(const mu_thunk_t *thunk, mu_time_rel_t budget);
+
+/**
+ * @brief Returns the budget entry for `thunk`, or NULL if it has none.
+ */
+const mu_sched_budget_t *mu_sched_budget(const mu_thunk_t *thunk);
+
+/**
+ * @brief Sets the function to call after a budget overrun, or NULL for none.
+ */
+void mu_sched_set_overrun_fn(mu_sched_overrun_fn fn);
+
+/**
+ * @brief Tells a long-running thunk that it should return soon.
+ *
+ * Meant to be polled by a thunk that works in chunks: once it returns true,
+ * the thunk should save its place, reschedule itself (e.g. with
+ * mu_sched_now()) and return so that other thunks get to run.
+ *
+ * @return true if the current thunk has used up its budget, false if it has
+ * time left, has no budget, or no thunk is running.
+ */
+bool mu_sched_should_yield(void);
+
 /**
  * @brief Returns the current time according to the scheduler's time source.
  * 
@@ -236,6 +1050,167 @@ const mu_thunk_t *mu_sched_current_thunk(void);
  */
 mu_time_abs_t mu_sched_current_time(void);
 
+// *****************************************************************************
+// Multi-instance API
+//
+// Each function below behaves exactly like its counterpart without the `_ex`
+// suffix, but operates on the given scheduler instance rather than the
+// default one.  Functions given a NULL or uninitialized instance fail the same
+// way their counterparts do before mu_sched_init().
+
+/**
+ * @brief Returns the default scheduler instance used by the non-_ex API.
+ */
+mu_sched_t *mu_sched_default(void);
+
+bool mu_sched_init_ex(mu_sched_t *sched, mu_spsc_t *interrupt_q,
+                      mu_pqueue_t *asap_q, mu_pvec_t *event_q,
+                      mu_pool_t *event_pool);
+
+bool mu_sched_init_wheel_ex(mu_sched_t *sched, mu_spsc_t *interrupt_q,
+                            mu_pqueue_t *asap_q, mu_sched_wheel_t *event_wheel,
+                            mu_pool_t *event_pool);
+
+bool mu_sched_init_heap_ex(mu_sched_t *sched, mu_spsc_t *interrupt_q,
+                           mu_pqueue_t *asap_q, mu_sched_heap_t *event_heap,
+                           mu_pool_t *event_pool);
+
+bool mu_sched_now_ex(mu_sched_t *sched, mu_thunk_t *thunk);
+
+bool mu_sched_now_deadline_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                              mu_time_abs_t deadline);
+
+bool mu_sched_now_args_ex(mu_sched_t *sched, mu_thunk_t *thunk, void *args);
+
+bool mu_sched_now_once_ex(mu_sched_t *sched, mu_sched_once_t *once);
+
+bool mu_sched_now_many_ex(mu_sched_t *sched, mu_thunk_t *const *thunks,
+                          size_t n);
+
+bool mu_sched_at_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                    mu_time_abs_t timestamp);
+
+bool mu_sched_at_many_ex(mu_sched_t *sched, mu_thunk_t *const *thunks,
+                         const mu_time_abs_t *timestamps, size_t n);
+
+bool mu_sched_at_args_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                         mu_time_abs_t timestamp, void *args);
+
+bool mu_sched_in_ex(mu_sched_t *sched, mu_thunk_t *thunk, mu_time_rel_t delay);
+
+bool mu_sched_at_handle_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                           mu_time_abs_t timestamp, mu_sched_handle_t *handle);
+
+bool mu_sched_in_handle_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                           mu_time_rel_t delay, mu_sched_handle_t *handle);
+
+bool mu_sched_in_slack_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                          mu_time_rel_t delay, mu_time_rel_t slack,
+                          mu_sched_handle_t *handle);
+
+bool mu_sched_every_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                       mu_time_rel_t period);
+
+bool mu_sched_every_handle_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                              mu_time_rel_t period, mu_sched_handle_t *handle);
+
+bool mu_sched_at_event_ex(mu_sched_t *sched, mu_event_t *evt,
+                          mu_thunk_t *thunk, mu_time_abs_t timestamp);
+
+bool mu_sched_in_event_ex(mu_sched_t *sched, mu_event_t *evt,
+                          mu_thunk_t *thunk, mu_time_rel_t delay);
+
+bool mu_sched_cancel_event_ex(mu_sched_t *sched, mu_event_t *evt);
+
+/**
+ * @note The handle must have been issued by the same instance.
+ */
+bool mu_sched_cancel_ex(mu_sched_t *sched, mu_sched_handle_t *handle);
+
+bool mu_sched_from_isr_ex(mu_sched_t *sched, mu_thunk_t *thunk);
+
+bool mu_sched_from_isr_args_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                               void *args);
+
+bool mu_sched_from_isr_once_ex(mu_sched_t *sched, mu_sched_once_t *once);
+
+bool mu_sched_now_prio_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                          unsigned level);
+
+bool mu_sched_set_prio_queue_ex(mu_sched_t *sched, unsigned level,
+                                mu_pqueue_t *prio_q);
+
+void mu_sched_set_overload_policy_ex(mu_sched_t *sched,
+                                     mu_sched_overload_t policy);
+
+const mu_sched_overload_stats_t *mu_sched_overload_stats_ex(mu_sched_t *sched);
+
+void mu_sched_overload_stats_reset_ex(mu_sched_t *sched);
+
+void mu_sched_set_lazy_promotion_ex(mu_sched_t *sched, bool enabled);
+
+void mu_sched_set_edf_queue_ex(mu_sched_t *sched, mu_sched_edf_t *edf_q);
+
+void mu_sched_sim_start_ex(mu_sched_t *sched, mu_time_abs_t start);
+
+void mu_sched_sim_stop_ex(mu_sched_t *sched);
+
+void mu_sched_sim_advance_ex(mu_sched_t *sched, mu_time_rel_t dt);
+
+size_t mu_sched_sim_run_until_ex(mu_sched_t *sched, mu_time_abs_t end);
+
+void mu_sched_set_remote_queue_ex(mu_sched_t *sched,
+                                  struct mu_sched_mpsc *remote_q);
+
+bool mu_sched_post_remote_ex(mu_sched_t *sched, mu_thunk_t *thunk);
+
+int mu_sched_delete_thunk_events_ex(mu_sched_t *sched, mu_thunk_t *thunk);
+
+void mu_sched_set_idle_thunk_ex(mu_sched_t *sched, mu_thunk_t *idle_thunk);
+
+void mu_sched_set_time_fn_ex(mu_sched_t *sched, mu_time_abs_t (*fn)(void));
+
+void mu_sched_set_coarse_clock_ex(mu_sched_t *sched, bool enabled);
+
+void mu_sched_step_ex(mu_sched_t *sched);
+
+size_t mu_sched_step_n_ex(mu_sched_t *sched, size_t max_thunks);
+
+bool mu_sched_take_ready_ex(mu_sched_t *sched, mu_thunk_t **thunk);
+
+bool mu_sched_take_ready_args_ex(mu_sched_t *sched, mu_thunk_t **thunk,
+                                 void **args);
+
+void mu_sched_run_ex(mu_sched_t *sched, mu_thunk_t *thunk);
+
+void mu_sched_run_args_ex(mu_sched_t *sched, mu_thunk_t *thunk, void *args);
+
+bool mu_sched_has_runnable_thunk_ex(mu_sched_t *sched);
+
+bool mu_sched_snapshot_ex(mu_sched_t *sched, mu_sched_snapshot_t *snap,
+                          mu_sched_pending_t *pending, size_t max_pending);
+
+bool mu_sched_next_deadline_ex(mu_sched_t *sched, mu_time_abs_t *out);
+
+bool mu_sched_idle_timeout_ex(mu_sched_t *sched, mu_time_rel_t *timeout);
+
+const mu_thunk_t *mu_sched_current_thunk_ex(mu_sched_t *sched);
+
+bool mu_sched_set_budget_table_ex(mu_sched_t *sched, mu_sched_budget_t *table,
+                                  size_t capacity);
+
+bool mu_sched_set_budget_ex(mu_sched_t *sched, const mu_thunk_t *thunk,
+                            mu_time_rel_t budget);
+
+const mu_sched_budget_t *mu_sched_budget_ex(mu_sched_t *sched,
+                                            const mu_thunk_t *thunk);
+
+void mu_sched_set_overrun_fn_ex(mu_sched_t *sched, mu_sched_overrun_fn fn);
+
+bool mu_sched_should_yield_ex(mu_sched_t *sched);
+
+mu_time_abs_t mu_sched_current_time_ex(mu_sched_t *sched);
+
 // *****************************************************************************
 // End of file
 
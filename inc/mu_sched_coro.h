@@ -0,0 +1,256 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_coro.h
+ * @brief Stackless coroutines layered on mu_thunk_t and mu_sched.
+ *
+ * A coroutine is a thunk whose function can suspend itself in the middle of
+ * a sequence (waiting for a delay, a signal or a condition, or yielding to
+ * other thunks) and resume at the same place the next time it runs.  It is
+ * built protothread-style from a switch statement on a saved resume point,
+ * so it needs no stack of its own and no heap allocation: its only state is
+ * a mu_coro_t, typically the first member of the caller's own context:
+ *
+ *     typedef struct {
+ *         mu_coro_t coro; // must be first
+ *         int retries;
+ *     } probe_t;
+ *
+ *     static void probe_fn(mu_thunk_t *thunk, void *args) {
+ *         probe_t *probe = (probe_t *)thunk;
+ *         (void)args;
+ *         MU_CORO_BEGIN(&probe->coro);
+ *         for (probe->retries = 0; probe->retries < 3; probe->retries++) {
+ *             radio_send();
+ *             MU_CORO_AWAIT_DELAY(&probe->coro, 10000000); // 10 ms
+ *             if (radio_read()) {
+ *                 break;
+ *             }
+ *         }
+ *         MU_CORO_END(&probe->coro);
+ *     }
+ *
+ *     mu_coro_init(&probe.coro, probe_fn, NULL);
+ *     mu_coro_start(&probe.coro);
+ *
+ * Because the function returns at every suspension point:
+ * - local variables do not survive an await; keep state in the context;
+ * - the await macros may only be used directly in the coroutine function,
+ *   between MU_CORO_BEGIN() and MU_CORO_END(), and not inside a nested
+ *   switch statement;
+ * - at most one await macro may appear on any one source line.
+ */
+
+#ifndef MU_SCHED_CORO_H
+#define MU_SCHED_CORO_H
+
+// *****************************************************************************
+// Includes
+
+#include "mu_sched.h"        // For mu_sched_in_ex(), mu_sched_now_ex()
+#include "mu_sched_signal.h" // For mu_sched_signal_wait()
+#include "mu_thunk.h"        // For mu_thunk_t definition
+#include "mu_time.h"         // For mu_time_rel_t
+#include <stdbool.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/**
+ * Marks the deliberate fall-through into each resume point, for compilers
+ * that warn about implicit fall-through.
+ */
+#if defined(__cplusplus) && __cplusplus >= 201703L
+#define MU_CORO_FALLTHROUGH_ [[fallthrough]]
+#elif defined(__has_attribute)
+#if __has_attribute(fallthrough)
+#define MU_CORO_FALLTHROUGH_ __attribute__((fallthrough))
+#endif
+#endif
+#ifndef MU_CORO_FALLTHROUGH_
+#define MU_CORO_FALLTHROUGH_ ((void)0)
+#endif
+
+/** Resume point of a coroutine that has not started, or was restarted. */
+#define MU_CORO_STATE_START 0
+
+/** Resume point of a coroutine that has run to MU_CORO_END(). */
+#define MU_CORO_STATE_DONE (-1)
+
+/**
+ * @brief A stackless coroutine.
+ *
+ * Initialize with mu_coro_init().  The fields are private to the macros
+ * below, except `failed`, which is set if the scheduler could not accept the
+ * coroutine at a suspension point (its ready queue or event pool was full).
+ * The coroutine then carries on without waiting.
+ */
+typedef struct {
+    mu_thunk_t thunk; /**< Must be first: the coroutine is scheduled as this */
+    mu_sched_t *sched; /**< The scheduler the coroutine runs on */
+    int state;         /**< Resume point: a source line, START or DONE */
+    bool failed;       /**< Set when a suspension could not be scheduled */
+} mu_coro_t;
+
+/**
+ * @brief Opens the coroutine body.  Must be the first statement.
+ */
+#define MU_CORO_BEGIN(coro)                                                    \
+    switch ((coro)->state) {                                                   \
+    case MU_CORO_STATE_START:
+
+/**
+ * @brief Closes the coroutine body and returns.  Once it has been reached,
+ * running the coroutine again does nothing until mu_coro_restart().
+ */
+#define MU_CORO_END(coro)                                                      \
+    MU_CORO_FALLTHROUGH_;                                                      \
+    default:;                                                                  \
+    }                                                                          \
+    (coro)->state = MU_CORO_STATE_DONE;                                        \
+    return
+
+/**
+ * @brief Finishes the coroutine early, as if it had reached MU_CORO_END().
+ */
+#define MU_CORO_EXIT(coro)                                                     \
+    do {                                                                       \
+        (coro)->state = MU_CORO_STATE_DONE;                                    \
+        return;                                                                \
+    } while (0)
+
+/**
+ * @brief Suspends the coroutine for `delay` (a mu_time_rel_t).
+ */
+#define MU_CORO_AWAIT_DELAY(coro, delay)                                       \
+    MU_CORO_SUSPEND_(coro, mu_sched_in_ex((coro)->sched, &(coro)->thunk,       \
+                                          (delay)))
+
+/**
+ * @brief Lets every other ready thunk run, then resumes.
+ */
+#define MU_CORO_YIELD(coro)                                                    \
+    MU_CORO_SUSPEND_(coro, mu_sched_now_ex((coro)->sched, &(coro)->thunk))
+
+/**
+ * @brief Suspends until `sig` (a mu_sched_signal_t *) is next raised.
+ */
+#define MU_CORO_AWAIT_SIGNAL(coro, sig)                                        \
+    MU_CORO_SUSPEND_(coro, mu_sched_signal_wait((sig), &(coro)->thunk))
+
+/**
+ * @brief Suspends until `cond` is true, re-testing it after each yield.
+ *
+ * This polls.  For an external event, prefer MU_CORO_AWAIT_SIGNAL().
+ */
+#define MU_CORO_AWAIT_UNTIL(coro, cond)                                        \
+    do {                                                                       \
+        (coro)->state = __LINE__;                                              \
+        MU_CORO_FALLTHROUGH_;                                                  \
+    case __LINE__:                                                             \
+        if (!(cond)) {                                                         \
+            if (mu_sched_now_ex((coro)->sched, &(coro)->thunk)) {              \
+                return;                                                        \
+            }                                                                  \
+            (coro)->failed = true;                                             \
+        }                                                                      \
+    } while (0)
+
+/**
+ * @brief Saves the resume point, then returns if `schedule` succeeds.
+ * Implementation detail of the await macros.
+ */
+#define MU_CORO_SUSPEND_(coro, schedule)                                       \
+    do {                                                                       \
+        (coro)->state = __LINE__;                                              \
+        if (schedule) {                                                        \
+            return;                                                            \
+        }                                                                      \
+        (coro)->failed = true;                                                 \
+        MU_CORO_FALLTHROUGH_;                                                  \
+    case __LINE__:;                                                            \
+    } while (0)
+
+// *****************************************************************************
+// Public function prototypes
+
+/**
+ * @brief Initializes a coroutine.
+ *
+ * @param coro The coroutine to initialize.
+ * @param fn The coroutine function, written with the MU_CORO_xxx() macros.
+ * @param sched The scheduler instance to run on, or NULL for the default one.
+ * @return coro.
+ */
+static inline mu_coro_t *mu_coro_init(mu_coro_t *coro, mu_thunk_fn fn,
+                                      mu_sched_t *sched) {
+    mu_thunk_init(&coro->thunk, fn);
+    coro->sched = sched ? sched : mu_sched_default();
+    coro->state = MU_CORO_STATE_START;
+    coro->failed = false;
+    return coro;
+}
+
+/**
+ * @brief Schedules the coroutine to run (or resume) as soon as possible.
+ */
+static inline bool mu_coro_start(mu_coro_t *coro) {
+    return mu_sched_now_ex(coro->sched, &coro->thunk);
+}
+
+/**
+ * @brief Rewinds the coroutine to its beginning.  Does not schedule it.
+ *
+ * The coroutine must not be pending in the scheduler.
+ */
+static inline void mu_coro_restart(mu_coro_t *coro) {
+    coro->state = MU_CORO_STATE_START;
+    coro->failed = false;
+}
+
+/**
+ * @brief Returns true once the coroutine has reached MU_CORO_END().
+ */
+static inline bool mu_coro_is_done(const mu_coro_t *coro) {
+    return coro->state == MU_CORO_STATE_DONE;
+}
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MU_SCHED_CORO_H */
@@ -0,0 +1,151 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_edf.h
+ * @brief Earliest-deadline-first ready queue for mu_sched.
+ *
+ * By default ready thunks wait in the FIFO asap_q, so a thunk promoted late
+ * from the event store still queues behind everything made ready before it.
+ * Attaching an EDF queue with mu_sched_set_edf_queue() instead orders ready
+ * thunks by deadline, so mu_sched_step() always runs the most urgent one:
+ *
+ * - a thunk promoted from the event store carries its scheduled time;
+ * - a thunk passed to mu_sched_now() or posted from another thread carries
+ *   the time it became ready;
+ * - mu_sched_now_deadline() sets the deadline explicitly.
+ *
+ * Without explicit deadlines this degenerates to first-come, first-served.
+ * Equal deadlines are served first-in, first-out.  Put and get are O(log n)
+ * on a binary heap held in a user-provided array.
+ */
+
+#ifndef MU_SCHED_EDF_H
+#define MU_SCHED_EDF_H
+
+// *****************************************************************************
+// Includes
+
+#include "mu_event.h" // For mu_event_time_t
+#include "mu_thunk.h" // For mu_thunk_t definition
+#include "mu_time.h"  // For mu_time_abs_t
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/**
+ * @brief One ready thunk and its deadline.
+ */
+typedef struct {
+    mu_thunk_t *thunk;        /**< The ready thunk */
+    mu_event_time_t deadline; /**< When it should have run by */
+    uint32_t seq;             /**< Arrival order, breaks deadline ties */
+} mu_sched_edf_entry_t;
+
+/**
+ * @brief A bounded deadline-ordered queue of ready thunks.
+ *
+ * Treat as opaque: initialize with mu_sched_edf_init().
+ */
+typedef struct {
+    mu_sched_edf_entry_t *items; /**< User-provided backing store */
+    size_t capacity;             /**< Number of slots in items */
+    size_t count;                /**< Number of thunks queued */
+    uint32_t seq;                /**< Next arrival sequence number */
+} mu_sched_edf_t;
+
+// *****************************************************************************
+// Public function prototypes
+
+/**
+ * @brief Initializes an empty EDF queue.
+ *
+ * @param edf The queue to initialize.
+ * @param store Backing store of `capacity` entries.
+ * @param capacity Maximum number of ready thunks.  Must be non-zero.
+ * @return edf on success, NULL on invalid parameters.
+ */
+mu_sched_edf_t *mu_sched_edf_init(mu_sched_edf_t *edf,
+                                  mu_sched_edf_entry_t *store,
+                                  size_t capacity);
+
+/**
+ * @brief Returns the number of queued thunks.
+ */
+size_t mu_sched_edf_count(const mu_sched_edf_t *edf);
+
+/**
+ * @brief Returns the number of thunks the queue can hold.
+ */
+size_t mu_sched_edf_capacity(const mu_sched_edf_t *edf);
+
+/**
+ * @brief Returns true if no thunks are queued.
+ */
+bool mu_sched_edf_is_empty(const mu_sched_edf_t *edf);
+
+/**
+ * @brief Returns true if the queue is at capacity.
+ */
+bool mu_sched_edf_is_full(const mu_sched_edf_t *edf);
+
+/**
+ * @brief Queues a thunk with the given deadline.  O(log n).
+ *
+ * @return true on success, false if the queue is full.
+ */
+bool mu_sched_edf_put(mu_sched_edf_t *edf, mu_thunk_t *thunk,
+                      mu_time_abs_t deadline);
+
+/**
+ * @brief Removes the thunk with the earliest deadline.  O(log n).
+ *
+ * @return true on success, false if the queue is empty.
+ */
+bool mu_sched_edf_get(mu_sched_edf_t *edf, mu_thunk_t **thunk);
+
+/**
+ * @brief Reads the earliest deadline without removing its thunk.
+ *
+ * @return true on success, false if the queue is empty.
+ */
+bool mu_sched_edf_peek_deadline(const mu_sched_edf_t *edf,
+                                mu_event_time_t *deadline);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MU_SCHED_EDF_H */
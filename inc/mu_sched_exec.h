@@ -0,0 +1,186 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_exec.h
+ * @brief Work-stealing thread pool built from mu_sched instances.
+ *
+ * Each worker thread owns one mu_sched_t.  A worker repeatedly takes its
+ * scheduler's next ready thunk (see mu_sched_take_ready_ex()) into a small
+ * ready ring and runs thunks from that ring.  A worker whose ring is empty
+ * steals ready thunks from its siblings' rings instead of running an idle
+ * thunk, and parks only when there is nothing to steal.
+ *
+ * Timed events never migrate: they stay in the event store of the worker
+ * that scheduled them and are promoted by that worker.  Only thunks that are
+ * ready to run move between workers, so a thunk may run on a different worker
+ * from the one that scheduled it.
+ *
+ * A thunk posted more than once may sit in several ready rings at a time.
+ * Before running a thunk a worker publishes it as its running thunk and
+ * checks its siblings; if another worker is already running that thunk, the
+ * copy goes back on the ready ring for later.  A given thunk therefore never
+ * runs on two workers at once, so thunks need not be reentrant.
+ *
+ * Thunks running on a worker schedule further work through
+ * mu_sched_exec_current(), e.g. `mu_sched_in_ex(mu_sched_exec_current(), ...)`.
+ * Other threads submit work with mu_sched_exec_post().
+ *
+ * Requires POSIX threads and the GNU __atomic builtins (GCC or Clang).  The
+ * shared fields below are plain volatile members so that this header stays
+ * usable from C++.
+ */
+
+#ifndef MU_SCHED_EXEC_H
+#define MU_SCHED_EXEC_H
+
+// *****************************************************************************
+// Includes
+
+#include "mu_sched.h"      // For mu_sched_t
+#include "mu_sched_mpsc.h" // For mu_sched_mpsc_t
+#include "mu_thunk.h"      // For mu_thunk_t definition
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_SCHED_EXEC_MAX_PARK_NS
+/** Upper bound on how long an idle worker sleeps before looking for work. */
+#define MU_SCHED_EXEC_MAX_PARK_NS 1000000
+#endif
+
+/** One slot of a worker's ready ring. */
+typedef struct {
+    mu_thunk_t *volatile thunk; /**< The ready thunk */
+    void *volatile args;        /**< Its argument (see mu_sched_now_args()) */
+} mu_sched_exec_slot_t;
+
+struct mu_sched_exec;
+
+/**
+ * @brief A worker thread and the scheduler it owns.
+ *
+ * Set up with mu_sched_exec_worker_init(); contents are private.
+ */
+typedef struct {
+    mu_sched_t *sched;              /**< The worker's scheduler */
+    mu_sched_exec_slot_t *ready;    /**< Ready ring backing store */
+    size_t mask;                    /**< Ready ring capacity - 1 */
+    volatile size_t top;            /**< Next ready slot to take (any thread) */
+    volatile size_t bottom;         /**< Next ready slot to fill (owner only) */
+    mu_thunk_t *volatile running;   /**< Thunk being run, or NULL */
+    struct mu_sched_exec *exec;     /**< The executor running this worker */
+    pthread_t thread;               /**< The worker's thread */
+} mu_sched_exec_worker_t;
+
+/**
+ * @brief A pool of workers.  Contents are private.
+ */
+typedef struct mu_sched_exec {
+    mu_sched_exec_worker_t *workers; /**< Array of workers */
+    size_t worker_count;             /**< Number of workers */
+    volatile size_t next_post;       /**< Round-robin cursor for posting */
+    volatile int parked;             /**< Number of workers waiting for work */
+    volatile bool stopping;          /**< Set by mu_sched_exec_stop() */
+    bool running;                    /**< True between start and stop */
+    pthread_mutex_t park_lock;       /**< Guards park_cond */
+    pthread_cond_t park_cond;        /**< Signalled when work appears */
+} mu_sched_exec_t;
+
+// *****************************************************************************
+// Public function prototypes
+
+/**
+ * @brief Prepares a worker.
+ *
+ * @param worker The worker to initialize.
+ * @param sched An initialized scheduler (mu_sched_init_ex() or
+ * mu_sched_init_wheel_ex()) for exclusive use by this worker.
+ * @param remote_q An initialized MPSC queue through which other threads post
+ * to this worker.  It is attached to `sched`.
+ * @param ready Backing store for the worker's ready ring.
+ * @param ready_capacity Number of slots in `ready`.  Must be a power of two.
+ * @return true on success, false on invalid parameters.
+ */
+bool mu_sched_exec_worker_init(mu_sched_exec_worker_t *worker,
+                               mu_sched_t *sched, mu_sched_mpsc_t *remote_q,
+                               mu_sched_exec_slot_t *ready,
+                               size_t ready_capacity);
+
+/**
+ * @brief Initializes an executor over an array of prepared workers.
+ *
+ * @return true on success, false on invalid parameters.
+ */
+bool mu_sched_exec_init(mu_sched_exec_t *exec, mu_sched_exec_worker_t *workers,
+                        size_t worker_count);
+
+/**
+ * @brief Starts one thread per worker.
+ *
+ * @return true if every thread started.  On failure any threads already
+ * started are stopped again.
+ */
+bool mu_sched_exec_start(mu_sched_exec_t *exec);
+
+/**
+ * @brief Asks every worker to stop and waits for their threads to exit.
+ *
+ * Thunks still queued when the workers stop are left in place and run if
+ * the executor is started again.
+ */
+void mu_sched_exec_stop(mu_sched_exec_t *exec);
+
+/**
+ * @brief Submits a thunk from any thread.
+ *
+ * Posts the thunk to the workers' remote queues in round-robin order and
+ * wakes a parked worker.
+ *
+ * @return true on success, false if every worker's remote queue is full.
+ */
+bool mu_sched_exec_post(mu_sched_exec_t *exec, mu_thunk_t *thunk);
+
+/**
+ * @brief Returns the scheduler of the worker running the calling thread, or
+ * NULL when called from a thread that is not a worker.
+ */
+mu_sched_t *mu_sched_exec_current(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MU_SCHED_EXEC_H */
@@ -0,0 +1,181 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_heap.h
+ * @brief d-ary min-heap event store for mu_sched.
+ *
+ * The heap is an alternative to the sorted mu_pvec event queue and the timer
+ * wheel.  Inserting an event, removing the soonest one and cancelling an
+ * arbitrary one are O(log n), with no loss of timestamp resolution.
+ *
+ * Events are ordered by timestamp and then by insertion sequence number (see
+ * mu_event_is_before()), so events scheduled for the same time run first-in,
+ * first-out just as they do with the mu_pvec event queue.  Each event records
+ * its own position in the heap, which is what makes cancellation O(log n).
+ *
+ * The heap stores mu_event_t pointers in a user-provided array.
+ */
+
+#ifndef MU_SCHED_HEAP_H
+#define MU_SCHED_HEAP_H
+
+// *****************************************************************************
+// Includes
+
+#include "mu_event.h" // For mu_event_t
+#include "mu_thunk.h" // For mu_thunk_t definition
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_SCHED_HEAP_ARITY
+/**
+ * Children per heap node.  Four halves the depth of a binary heap and keeps
+ * each node's children in one or two cache lines.
+ */
+#define MU_SCHED_HEAP_ARITY 4
+#endif
+
+/**
+ * @brief The fields of an event that the heap orders and searches by.
+ *
+ * A heap initialized with mu_sched_heap_init_keyed() keeps a copy of each
+ * event's key in an array parallel to its event pointers.
+ */
+typedef struct {
+    mu_event_time_t timestamp; /**< Copy of the event's timestamp */
+    uint32_t seq;              /**< Copy of the event's sequence number */
+    const mu_thunk_t *thunk;   /**< Copy of the event's thunk */
+} mu_sched_heap_key_t;
+
+/**
+ * @brief A d-ary min-heap of mu_event_t objects.
+ *
+ * Treat as opaque: initialize with mu_sched_heap_init() or
+ * mu_sched_heap_init_keyed() and pass to mu_sched_init_heap().
+ */
+typedef struct {
+    mu_event_t **items;        /**< User-provided backing store */
+    mu_sched_heap_key_t *keys; /**< Optional keys parallel to items */
+    size_t capacity;           /**< Number of slots in items */
+    size_t count;              /**< Number of events held by the heap */
+} mu_sched_heap_t;
+
+// *****************************************************************************
+// Public function prototypes
+
+/**
+ * @brief Initializes an empty heap.
+ *
+ * @param heap The heap to initialize.
+ * @param store Backing store of `capacity` event pointers.
+ * @param capacity Maximum number of pending events.  Must be non-zero.
+ * @return heap on success, NULL on invalid parameters.
+ */
+mu_sched_heap_t *mu_sched_heap_init(mu_sched_heap_t *heap, mu_event_t **store,
+                                    size_t capacity);
+
+/**
+ * @brief Initializes an empty heap that keeps event keys in its own array.
+ *
+ * Sifting and mu_sched_heap_remove_thunk() then read timestamps, sequence
+ * numbers and thunks from `keys`, which is contiguous, instead of from the
+ * events, which may be scattered across the event pool.  An event's
+ * timestamp and thunk must not change while the heap holds it (the
+ * scheduler never does so).
+ *
+ * @param heap The heap to initialize.
+ * @param store Backing store of `capacity` event pointers.
+ * @param keys Backing store of `capacity` keys.
+ * @param capacity Maximum number of pending events.  Must be non-zero.
+ * @return heap on success, NULL on invalid parameters.
+ */
+mu_sched_heap_t *mu_sched_heap_init_keyed(mu_sched_heap_t *heap,
+                                          mu_event_t **store,
+                                          mu_sched_heap_key_t *keys,
+                                          size_t capacity);
+
+/**
+ * @brief Returns the number of events held by the heap.
+ */
+size_t mu_sched_heap_count(const mu_sched_heap_t *heap);
+
+/**
+ * @brief Returns the number of events the heap can hold.
+ */
+size_t mu_sched_heap_capacity(const mu_sched_heap_t *heap);
+
+/**
+ * @brief Adds an event.
+ *
+ * @return true on success, false if the heap is full.
+ */
+bool mu_sched_heap_insert(mu_sched_heap_t *heap, mu_event_t *evt);
+
+/**
+ * @brief Returns the soonest event without removing it, or NULL if empty.
+ */
+mu_event_t *mu_sched_heap_peek(const mu_sched_heap_t *heap);
+
+/**
+ * @brief Removes and returns the soonest event, or NULL if empty.
+ */
+mu_event_t *mu_sched_heap_pop(mu_sched_heap_t *heap);
+
+/**
+ * @brief Removes an event held by the heap.  O(log n).
+ */
+void mu_sched_heap_remove(mu_sched_heap_t *heap, mu_event_t *evt);
+
+/**
+ * @brief Removes every event whose thunk is `thunk`.  O(n).
+ *
+ * @return The removed events, linked through their `next` fields, or NULL.
+ */
+mu_event_t *mu_sched_heap_remove_thunk(mu_sched_heap_t *heap,
+                                       const mu_thunk_t *thunk);
+
+/**
+ * @brief Calls `fn` for every event held by the heap, in heap order.  O(n).
+ */
+void mu_sched_heap_visit(const mu_sched_heap_t *heap, mu_event_visit_fn fn,
+                         void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MU_SCHED_HEAP_H */
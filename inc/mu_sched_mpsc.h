@@ -0,0 +1,160 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_mpsc.h
+ * @brief Lock-free multi-producer, single-consumer thunk queue for mu_sched.
+ *
+ * mu_sched_mpsc lets any number of threads (or cores) hand mu_thunk_t
+ * pointers to a single scheduler without a mutex.  Producers are wait-free:
+ * mu_sched_mpsc_put() completes in a fixed number of atomic operations no
+ * matter what the other producers or the consumer are doing.  Only the thread
+ * that runs the scheduler may call mu_sched_mpsc_get().
+ *
+ * A producer first reserves capacity, then claims a slot index and publishes
+ * its item into that slot.  The consumer takes items in slot order and stops
+ * at the first slot whose producer has not yet published, so an item from a
+ * producer that is preempted mid-put is delivered on a later drain.
+ *
+ * The shared fields are plain volatile members so that this header stays
+ * usable from C++; src/mu_sched_mpsc.c accesses them atomically through GNU
+ * __atomic builtins, or C11 <stdatomic.h> where those are unavailable.
+ */
+
+#ifndef MU_SCHED_MPSC_H
+#define MU_SCHED_MPSC_H
+
+// *****************************************************************************
+// Includes
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+typedef enum {
+    MU_SCHED_MPSC_ERR_NONE = 0,
+    MU_SCHED_MPSC_ERR_EMPTY,
+    MU_SCHED_MPSC_ERR_FULL,
+    MU_SCHED_MPSC_ERR_SIZE,
+} mu_sched_mpsc_err_t;
+
+/** One slot of the backing store.  A NULL item marks an empty slot. */
+typedef struct {
+    void *volatile item; /**< The queued item, published last */
+    void *args;          /**< Payload carried alongside the item */
+} mu_sched_mpsc_slot_t;
+
+typedef struct mu_sched_mpsc {
+    mu_sched_mpsc_slot_t *store; /**< User-provided backing store */
+    size_t mask;                 /**< capacity - 1 */
+    volatile size_t reserved;    /**< Items claimed but not yet consumed */
+    volatile size_t tail;        /**< Next slot index to hand to a producer */
+    size_t head;                 /**< Next slot index to consume */
+} mu_sched_mpsc_t;
+
+// *****************************************************************************
+// Public function prototypes
+
+/**
+ * @brief Initializes an MPSC queue.
+ *
+ * @param q The queue to initialize.
+ * @param store Backing store of `capacity` slots.
+ * @param capacity Number of slots.  Must be a power of two.
+ * @return MU_SCHED_MPSC_ERR_NONE on success, MU_SCHED_MPSC_ERR_SIZE if
+ * `capacity` is not a power of two or a parameter is NULL.
+ */
+mu_sched_mpsc_err_t mu_sched_mpsc_init(mu_sched_mpsc_t *q,
+                                       mu_sched_mpsc_slot_t *store,
+                                       size_t capacity);
+
+/**
+ * @brief Adds an item to the queue.  Wait-free; callable from any thread.
+ *
+ * @param q The queue.
+ * @param item The item to add.  Must not be NULL.
+ * @return MU_SCHED_MPSC_ERR_NONE on success, MU_SCHED_MPSC_ERR_FULL if the
+ * queue is full.
+ */
+mu_sched_mpsc_err_t mu_sched_mpsc_put(mu_sched_mpsc_t *q, void *item);
+
+/**
+ * @brief Adds an item and a payload pointer in one slot.  Wait-free.
+ *
+ * Same as mu_sched_mpsc_put(), but `args` travels with the item and is
+ * returned by mu_sched_mpsc_get_args().
+ */
+mu_sched_mpsc_err_t mu_sched_mpsc_put_args(mu_sched_mpsc_t *q, void *item,
+                                           void *args);
+
+/**
+ * @brief Removes the oldest published item.  Consumer thread only.
+ *
+ * @param q The queue.
+ * @param item Receives the item.
+ * @return MU_SCHED_MPSC_ERR_NONE on success, MU_SCHED_MPSC_ERR_EMPTY if no
+ * published item is available.
+ */
+mu_sched_mpsc_err_t mu_sched_mpsc_get(mu_sched_mpsc_t *q, void **item);
+
+/**
+ * @brief Removes the oldest published item and its payload.  Consumer
+ * thread only.
+ *
+ * @param args Receives the payload (NULL if posted by mu_sched_mpsc_put()).
+ */
+mu_sched_mpsc_err_t mu_sched_mpsc_get_args(mu_sched_mpsc_t *q, void **item,
+                                           void **args);
+
+/**
+ * @brief Reports the oldest published item and its payload without removing
+ * them.  Consumer thread only.
+ *
+ * @return MU_SCHED_MPSC_ERR_NONE if an item is available,
+ * MU_SCHED_MPSC_ERR_EMPTY otherwise.
+ */
+mu_sched_mpsc_err_t mu_sched_mpsc_peek_args(mu_sched_mpsc_t *q, void **item,
+                                            void **args);
+
+/**
+ * @brief Returns true if mu_sched_mpsc_get() would fail.  Consumer thread
+ * only.
+ */
+bool mu_sched_mpsc_is_empty(mu_sched_mpsc_t *q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MU_SCHED_MPSC_H */
@@ -0,0 +1,144 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_signal.h
+ * @brief Signals that wake a batch of waiting thunks.
+ *
+ * A thunk that would otherwise re-schedule itself with mu_sched_now() just
+ * to poll a flag can instead register as a waiter on a mu_sched_signal_t and
+ * go idle.  mu_sched_signal_raise() then moves every registered waiter into
+ * the scheduler's ready queue in one pass, in the order they registered.
+ * Each raise wakes only the thunks waiting at that moment; a thunk that
+ * wants the next raise registers again.
+ *
+ * Interrupt handlers raise a signal with mu_sched_signal_raise_from_isr(),
+ * which posts the signal's own thunk through the interrupt queue so that the
+ * waiters are moved on the scheduler thread.  Several raises from ISRs before
+ * the scheduler gets to it coalesce into one.
+ *
+ * Waiters are held in a user-provided array.
+ */
+
+#ifndef MU_SCHED_SIGNAL_H
+#define MU_SCHED_SIGNAL_H
+
+// *****************************************************************************
+// Includes
+
+#include "mu_sched.h" // For mu_sched_t
+#include "mu_thunk.h" // For mu_thunk_t definition
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/**
+ * @brief A signal and its waiters.
+ *
+ * Treat as opaque: initialize with mu_sched_signal_init().
+ */
+typedef struct {
+    mu_thunk_t isr_thunk;         /**< Posted by raise_from_isr() */
+    mu_thunk_t **waiters;         /**< User-provided backing store */
+    size_t capacity;              /**< Number of slots in waiters */
+    size_t count;                 /**< Number of registered waiters */
+    mu_sched_t *isr_sched;        /**< Instance isr_thunk was posted to */
+    volatile uint8_t isr_pending; /**< Non-zero while isr_thunk is queued */
+} mu_sched_signal_t;
+
+// *****************************************************************************
+// Public function prototypes
+
+/**
+ * @brief Initializes a signal with no waiters.
+ *
+ * @param sig The signal to initialize.
+ * @param waiters Backing store of `capacity` thunk pointers.
+ * @param capacity Maximum number of waiters.  Must be non-zero.
+ * @return sig on success, NULL on invalid parameters.
+ */
+mu_sched_signal_t *mu_sched_signal_init(mu_sched_signal_t *sig,
+                                        mu_thunk_t **waiters, size_t capacity);
+
+/**
+ * @brief Registers a thunk to be woken by the next raise.
+ *
+ * Must be called from the scheduler thread (e.g., from thunk context).
+ *
+ * @return true on success, false if the waiter list is full.
+ */
+bool mu_sched_signal_wait(mu_sched_signal_t *sig, mu_thunk_t *thunk);
+
+/**
+ * @brief Unregisters every registration of `thunk`.
+ *
+ * @return The number of registrations removed.
+ */
+size_t mu_sched_signal_remove(mu_sched_signal_t *sig, const mu_thunk_t *thunk);
+
+/**
+ * @brief Returns the number of registered waiters.
+ */
+size_t mu_sched_signal_waiter_count(const mu_sched_signal_t *sig);
+
+/**
+ * @brief Wakes every registered waiter.
+ *
+ * Moves the waiters into the ready queue as if by mu_sched_now().  A waiter
+ * that does not fit (see mu_sched_set_overload_policy()) stays registered.
+ * Must be called from the scheduler thread.
+ *
+ * @return The number of waiters woken.
+ */
+size_t mu_sched_signal_raise(mu_sched_signal_t *sig);
+
+/**
+ * @brief Wakes every registered waiter, from interrupt context.
+ *
+ * @return true if the raise is pending or already was, false if the
+ * interrupt queue is full.
+ */
+bool mu_sched_signal_raise_from_isr(mu_sched_signal_t *sig);
+
+size_t mu_sched_signal_raise_ex(mu_sched_t *sched, mu_sched_signal_t *sig);
+
+bool mu_sched_signal_raise_from_isr_ex(mu_sched_t *sched,
+                                       mu_sched_signal_t *sig);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MU_SCHED_SIGNAL_H */
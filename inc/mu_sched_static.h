@@ -0,0 +1,134 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_static.h
+ * @brief Compile-time sized scheduler instances.
+ *
+ * MU_SCHED_DEFINE() declares a scheduler together with its interrupt queue,
+ * asap_q, event queue and event pool and their backing arrays, all with
+ * static storage, plus an init function that wires them up:
+ *
+ *     MU_SCHED_DEFINE(s_app_sched, 16, 32, 64);
+ *
+ *     int main(void) {
+ *         s_app_sched_init();
+ *         ...
+ *         mu_sched_now_ex(&s_app_sched, &led_task);
+ *         while (true) {
+ *             mu_sched_step_ex(&s_app_sched);
+ *         }
+ *     }
+ *
+ * The interrupt queue capacity must be a power of two, since the SPSC ring
+ * indexes with a mask.  This is checked at compile time, so a bad
+ * configuration fails the build rather than the init call.  The other
+ * capacities may be any positive size.
+ */
+
+#ifndef MU_SCHED_STATIC_H
+#define MU_SCHED_STATIC_H
+
+// *****************************************************************************
+// Includes
+
+#include "mu_event.h"  // For mu_event_t
+#include "mu_pool.h"   // For mu_pool_t, mu_pool_init()
+#include "mu_pqueue.h" // For mu_pqueue_t, mu_pqueue_init()
+#include "mu_pvec.h"   // For mu_pvec_t, mu_pvec_init()
+#include "mu_sched.h"  // For mu_sched_t, mu_sched_init_ex()
+#include "mu_spsc.h"   // For mu_spsc_t, mu_spsc_init()
+#include <stdbool.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/** True if `n` is a positive power of two.  Usable in constant expressions. */
+#define MU_SCHED_IS_POW2(n) ((n) > 0 && ((n) & ((n) - 1)) == 0)
+
+#ifdef __cplusplus
+#define MU_SCHED_STATIC_ASSERT_(cond, msg) static_assert(cond, msg)
+#else
+#define MU_SCHED_STATIC_ASSERT_(cond, msg) _Static_assert(cond, msg)
+#endif
+
+/**
+ * @brief Defines a scheduler instance `name` and its stores, sized at
+ * compile time, and a function `bool name##_init(void)` that initializes
+ * them all.
+ *
+ * Use at file scope.  Everything it defines is static to the file.
+ *
+ * @param name Name of the mu_sched_t instance.
+ * @param N_ISR Interrupt queue capacity.  A power of two up to 32768.
+ * @param N_ASAP asap_q capacity.
+ * @param N_EVENTS Event queue and event pool capacity.
+ */
+#define MU_SCHED_DEFINE(name, N_ISR, N_ASAP, N_EVENTS)                         \
+    MU_SCHED_STATIC_ASSERT_(MU_SCHED_IS_POW2(N_ISR) && (N_ISR) <= 32768,      \
+                            #name ": N_ISR must be a power of two <= 32768"); \
+    static mu_sched_t name;                                                    \
+    static struct {                                                            \
+        mu_spsc_t isr_q;                                                       \
+        mu_pqueue_t asap_q;                                                    \
+        mu_pvec_t event_q;                                                     \
+        mu_pool_t event_pool;                                                  \
+        mu_spsc_item_t isr_store[N_ISR];                                       \
+        void *asap_store[N_ASAP];                                              \
+        void *event_store[N_EVENTS];                                           \
+        mu_event_t pool_store[N_EVENTS];                                       \
+    } name##_stores_;                                                          \
+    static inline bool name##_init(void) {                                     \
+        mu_spsc_init(&name##_stores_.isr_q, name##_stores_.isr_store,          \
+                     (uint16_t)(N_ISR));                                       \
+        mu_pqueue_init(&name##_stores_.asap_q, name##_stores_.asap_store,      \
+                       (N_ASAP));                                              \
+        mu_pvec_init(&name##_stores_.event_q, name##_stores_.event_store,      \
+                     (N_EVENTS));                                              \
+        mu_pool_init(&name##_stores_.event_pool, name##_stores_.pool_store,    \
+                     (N_EVENTS), sizeof(mu_event_t));                          \
+        return mu_sched_init_ex(&name, &name##_stores_.isr_q,                  \
+                                &name##_stores_.asap_q,                        \
+                                &name##_stores_.event_q,                       \
+                                &name##_stores_.event_pool);                   \
+    }                                                                          \
+    MU_SCHED_STATIC_ASSERT_(true, #name)
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MU_SCHED_STATIC_H */
@@ -0,0 +1,141 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_stats.h
+ * @brief Optional per-thunk latency and runtime statistics for mu_sched.
+ *
+ * Compiled in only when MU_SCHED_STATS is defined (for every translation unit
+ * that includes mu_sched.h).  When enabled, the scheduler reads its clock
+ * before and after every thunk it runs and records, per thunk:
+ *
+ * - how many times it ran,
+ * - how long it ran (total and worst case), and
+ * - for runs triggered by a timed event, how late it started relative to the
+ *   event's timestamp (total and worst case).
+ *
+ * Lateness of every timed run is also added to a global log2 histogram.
+ *
+ * Thunks are tracked in a fixed-size table of MU_SCHED_STATS_THUNKS entries;
+ * runs of thunks that do not fit are only counted in `untracked_calls`.  If a
+ * thunk is promoted by several events before it gets to run, lateness is
+ * measured from the earliest of them.
+ */
+
+#ifndef MU_SCHED_STATS_H
+#define MU_SCHED_STATS_H
+
+#ifdef MU_SCHED_STATS
+
+// *****************************************************************************
+// Includes
+
+#include "mu_thunk.h" // For mu_thunk_t definition
+#include "mu_time.h"  // For mu_time_abs_t, mu_time_rel_t
+#include <stdbool.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_SCHED_STATS_THUNKS
+/** Number of distinct thunks tracked.  Must be a power of two. */
+#define MU_SCHED_STATS_THUNKS 32
+#endif
+
+#ifndef MU_SCHED_STATS_LAG_BUCKETS
+/**
+ * Number of lag histogram buckets.  Bucket 0 counts on-time runs; bucket
+ * N > 0 counts runs between 2^(N-1) and 2^N - 1 nanoseconds late, and the
+ * last bucket also counts everything later.
+ */
+#define MU_SCHED_STATS_LAG_BUCKETS 32
+#endif
+
+/** Statistics for one thunk. */
+typedef struct {
+    const mu_thunk_t *thunk;      /**< The thunk, or NULL for a free entry */
+    uint32_t calls;               /**< Number of runs */
+    uint32_t timed_calls;         /**< Runs triggered by a timed event */
+    mu_time_rel_t total_runtime;  /**< Sum of run durations */
+    mu_time_rel_t max_runtime;    /**< Longest run */
+    mu_time_rel_t total_lateness; /**< Sum of lateness over timed runs */
+    mu_time_rel_t max_lateness;   /**< Worst lateness */
+    mu_time_abs_t due;            /**< Timestamp of the pending timed run */
+    bool due_pending;             /**< True if `due` is valid */
+} mu_sched_thunk_stats_t;
+
+/** Statistics for one scheduler instance. */
+typedef struct {
+    mu_sched_thunk_stats_t thunks[MU_SCHED_STATS_THUNKS];
+    uint32_t lag_histogram[MU_SCHED_STATS_LAG_BUCKETS];
+    uint32_t untracked_calls; /**< Runs of thunks with no table entry */
+} mu_sched_stats_t;
+
+struct mu_sched_t;
+
+// *****************************************************************************
+// Public function prototypes
+
+/**
+ * @brief Returns the statistics gathered by the default scheduler.
+ *
+ * Entries in `thunks` are in no particular order; unused ones have a NULL
+ * `thunk`.
+ */
+const mu_sched_stats_t *mu_sched_stats(void);
+
+/**
+ * @brief Returns the statistics for one thunk, or NULL if it has not run or
+ * is not tracked.
+ */
+const mu_sched_thunk_stats_t *mu_sched_thunk_stats(const mu_thunk_t *thunk);
+
+/**
+ * @brief Clears all statistics.
+ */
+void mu_sched_stats_reset(void);
+
+const mu_sched_stats_t *mu_sched_stats_ex(struct mu_sched_t *sched);
+
+const mu_sched_thunk_stats_t *
+mu_sched_thunk_stats_ex(struct mu_sched_t *sched, const mu_thunk_t *thunk);
+
+void mu_sched_stats_reset_ex(struct mu_sched_t *sched);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MU_SCHED_STATS */
+
+#endif /* MU_SCHED_STATS_H */
@@ -0,0 +1,232 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_trace.h
+ * @brief Wait-free binary trace ring for scheduler events.
+ *
+ * A trace ring records what the scheduler does -- thunks queued, events
+ * promoted, thunks run, events cancelled -- as fixed-size records holding a
+ * 32-bit timestamp, the record type, the context that wrote it and the thunk
+ * pointer.  Writers claim a
+ * slot with a single atomic increment and never wait, so records may be
+ * added from thunks, interrupts and other threads alike.  When the ring is
+ * full the oldest records are overwritten.
+ *
+ * The scheduler writes to a ring attached with mu_sched_set_trace() when it
+ * is compiled with MU_SCHED_TRACE defined; without it the hooks compile to
+ * nothing.
+ *
+ * mu_sched_trace_write() serializes the ring (a header followed by records,
+ * oldest first).  tools/mu_sched_trace_json.c turns that into Chrome trace /
+ * Perfetto JSON on the host.
+ */
+
+#ifndef MU_SCHED_TRACE_H
+#define MU_SCHED_TRACE_H
+
+// *****************************************************************************
+// Includes
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#if !defined(__GNUC__) && !defined(__cplusplus)
+#include <stdatomic.h>
+#endif
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/** Magic number at the start of a serialized trace ("MUTR"). */
+#define MU_SCHED_TRACE_MAGIC 0x5254554dU
+#define MU_SCHED_TRACE_VERSION 2
+
+typedef enum {
+    MU_SCHED_TRACE_NOW = 1,   /**< mu_sched_now() queued a thunk */
+    MU_SCHED_TRACE_AT,        /**< mu_sched_at() / mu_sched_in() */
+    MU_SCHED_TRACE_ISR,       /**< mu_sched_from_isr() */
+    MU_SCHED_TRACE_REMOTE,    /**< mu_sched_post_remote() */
+    MU_SCHED_TRACE_PROMOTE,   /**< A due event moved to the asap_q */
+    MU_SCHED_TRACE_RUN_START, /**< A thunk started running */
+    MU_SCHED_TRACE_RUN_END,   /**< A thunk returned */
+    MU_SCHED_TRACE_CANCEL,    /**< mu_sched_cancel() */
+} mu_sched_trace_type_t;
+
+/**
+ * Where a record was written.  The scheduler uses the values below; callers
+ * of mu_sched_trace_put_ctx() may use any others up to 255, e.g. a worker
+ * index.
+ */
+typedef enum {
+    MU_SCHED_TRACE_CTX_SCHED = 0, /**< The thread running the scheduler */
+    MU_SCHED_TRACE_CTX_ISR,       /**< An interrupt handler */
+    MU_SCHED_TRACE_CTX_REMOTE,    /**< Another thread */
+} mu_sched_trace_context_t;
+
+/** One trace record. */
+typedef struct {
+    uint32_t timestamp; /**< Trace clock reading */
+    uint32_t info;      /**< Type in bits 0-7, context in bits 8-15 and
+                             sequence number in bits 16-31 */
+    uintptr_t thunk;    /**< Address of the thunk concerned */
+} mu_sched_trace_record_t;
+
+/**
+ * Header written by mu_sched_trace_write().  All fields are in the byte order
+ * of the target.
+ */
+typedef struct {
+    uint32_t magic;            /**< MU_SCHED_TRACE_MAGIC */
+    uint16_t version;          /**< MU_SCHED_TRACE_VERSION */
+    uint16_t record_size;      /**< sizeof(mu_sched_trace_record_t) */
+    uint32_t ticks_per_second; /**< Resolution of the trace clock */
+    uint32_t count;            /**< Number of records that follow */
+} mu_sched_trace_header_t;
+
+/**
+ * Claims the next record slot.  The head is a plain integer rather than a C11
+ * atomic so that this header stays usable from C++.
+ */
+#if defined(__GNUC__)
+#define MU_SCHED_TRACE_CLAIM(head)                                             \
+    __atomic_fetch_add((head), 1, __ATOMIC_RELAXED)
+#else
+#define MU_SCHED_TRACE_CLAIM(head)                                             \
+    atomic_fetch_add_explicit((_Atomic uint32_t *)(head), 1,                   \
+                              memory_order_relaxed)
+#endif
+
+/** Returns a free-running 32-bit timestamp. */
+typedef uint32_t (*mu_sched_trace_clock_t)(void);
+
+typedef struct mu_sched_trace {
+    mu_sched_trace_record_t *records; /**< User-provided backing store */
+    uint32_t mask;                    /**< capacity - 1 */
+    volatile uint32_t head;           /**< Records claimed, modulo 2^32 */
+    volatile bool full;               /**< Set once every slot was claimed */
+    mu_sched_trace_clock_t clock;     /**< Timestamp source */
+    uint32_t ticks_per_second;        /**< Resolution of `clock` */
+} mu_sched_trace_t;
+
+/**
+ * @brief Serialization sink: writes `len` bytes and returns the number
+ * written.
+ */
+typedef size_t (*mu_sched_trace_write_fn)(void *ctx, const void *buf,
+                                          size_t len);
+
+struct mu_sched_t;
+
+// *****************************************************************************
+// Public function prototypes
+
+/**
+ * @brief Initializes a trace ring.
+ *
+ * @param trace The ring to initialize.
+ * @param records Backing store of `capacity` records.
+ * @param capacity Number of records.  Must be a power of two.
+ * @param clock Timestamp source, e.g. a cycle counter.  NULL selects a
+ * microsecond clock derived from mu_time_now().
+ * @param ticks_per_second Rate of `clock`; ignored if `clock` is NULL.
+ * @return true on success, false on invalid parameters.
+ */
+bool mu_sched_trace_init(mu_sched_trace_t *trace,
+                         mu_sched_trace_record_t *records, size_t capacity,
+                         mu_sched_trace_clock_t clock,
+                         uint32_t ticks_per_second);
+
+/**
+ * @brief Adds a record written from `context` (a mu_sched_trace_context_t or
+ * a caller-defined value).  Wait-free; callable from any context.
+ */
+static inline void mu_sched_trace_put_ctx(mu_sched_trace_t *trace,
+                                          mu_sched_trace_type_t type,
+                                          unsigned context,
+                                          const void *thunk) {
+    uint32_t seq = MU_SCHED_TRACE_CLAIM(&trace->head);
+    mu_sched_trace_record_t *rec = &trace->records[seq & trace->mask];
+    rec->timestamp = trace->clock();
+    rec->thunk = (uintptr_t)thunk;
+    rec->info = (uint32_t)type | ((uint32_t)(context & 0xffU) << 8) |
+                (seq << 16);
+    if (seq == trace->mask) {
+        trace->full = true; // head alone cannot tell once it wraps
+    }
+}
+
+/**
+ * @brief Adds a record from the scheduler's own thread.
+ */
+static inline void mu_sched_trace_put(mu_sched_trace_t *trace,
+                                      mu_sched_trace_type_t type,
+                                      const void *thunk) {
+    mu_sched_trace_put_ctx(trace, type, MU_SCHED_TRACE_CTX_SCHED, thunk);
+}
+
+/**
+ * @brief Returns the number of records currently held by the ring.
+ */
+size_t mu_sched_trace_count(const mu_sched_trace_t *trace);
+
+/**
+ * @brief Discards all records.
+ */
+void mu_sched_trace_clear(mu_sched_trace_t *trace);
+
+/**
+ * @brief Serializes the ring: a mu_sched_trace_header_t followed by the
+ * records, oldest first.
+ *
+ * Records added while the ring is being written may or may not be included;
+ * stop tracing first (e.g. detach the ring) for a consistent snapshot.
+ *
+ * @return The number of bytes written.
+ */
+size_t mu_sched_trace_write(const mu_sched_trace_t *trace,
+                            mu_sched_trace_write_fn write, void *ctx);
+
+#ifdef MU_SCHED_TRACE
+/**
+ * @brief Attaches a trace ring to the default scheduler; NULL detaches it.
+ */
+void mu_sched_set_trace(mu_sched_trace_t *trace);
+
+void mu_sched_set_trace_ex(struct mu_sched_t *sched, mu_sched_trace_t *trace);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MU_SCHED_TRACE_H */
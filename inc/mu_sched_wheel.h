@@ -0,0 +1,181 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_wheel.h
+ * @brief Hierarchical timer wheel event store for mu_sched.
+ *
+ * The timer wheel is an alternative to the sorted mu_pvec event queue.  Events
+ * are hashed into slots by timestamp, so inserting an event and expiring due
+ * events are O(1) amortized regardless of how many events are pending.
+ *
+ * Time is quantized into ticks of `ns_per_tick` nanoseconds.  The wheel has
+ * MU_SCHED_WHEEL_LEVELS levels of MU_SCHED_WHEEL_SLOTS slots each; level N
+ * covers events up to SLOTS^(N+1) ticks away.  Events beyond the last level
+ * are kept on an overflow list that is revisited each time the top level
+ * wraps.  Events are linked through their own mu_event_t link fields, so the
+ * wheel needs no backing store beyond the mu_sched_wheel_t itself.
+ *
+ * Due events are held on a sorted expiry list, ordered by timestamp and then
+ * by insertion order, so events scheduled for the same time run first-in,
+ * first-out just as they do with the mu_pvec event queue.
+ */
+
+#ifndef MU_SCHED_WHEEL_H
+#define MU_SCHED_WHEEL_H
+
+// *****************************************************************************
+// Includes
+
+#include "mu_event.h" // For mu_event_t
+#include "mu_thunk.h" // For mu_thunk_t definition
+#include "mu_time.h"  // For mu_time_abs_t
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_SCHED_WHEEL_BITS
+/** log2 of the number of slots per level.  Must be between 1 and 6. */
+#define MU_SCHED_WHEEL_BITS 6
+#endif
+
+#ifndef MU_SCHED_WHEEL_LEVELS
+/** Number of wheel levels before events spill onto the overflow list. */
+#define MU_SCHED_WHEEL_LEVELS 4
+#endif
+
+#define MU_SCHED_WHEEL_SLOTS (1u << MU_SCHED_WHEEL_BITS)
+
+/**
+ * @brief A hierarchical timer wheel of mu_event_t objects.
+ *
+ * Treat as opaque: initialize with mu_sched_wheel_init() and pass to
+ * mu_sched_init_wheel().
+ */
+typedef struct {
+    mu_event_t *slots[MU_SCHED_WHEEL_LEVELS][MU_SCHED_WHEEL_SLOTS];
+    uint64_t occupied[MU_SCHED_WHEEL_LEVELS]; /**< Slot occupancy bitmaps */
+    mu_event_t *overflow; /**< Events beyond the last level */
+    mu_event_t *expired;  /**< Due events, sorted soonest first */
+    uint64_t cursor;      /**< Tick up to which events have expired */
+    uint32_t ns_per_tick; /**< Wheel resolution */
+    size_t count;         /**< Number of events held by the wheel */
+} mu_sched_wheel_t;
+
+// *****************************************************************************
+// Public function prototypes
+
+/**
+ * @brief Initializes an empty timer wheel.
+ *
+ * @param wheel The wheel to initialize.
+ * @param ns_per_tick Wheel resolution in nanoseconds.  Events whose
+ *        timestamps fall in the same tick share a slot; finer resolution
+ *        costs more cascading, coarser resolution costs longer slot lists.
+ *        Must be non-zero.
+ * @return wheel on success, NULL on invalid parameters.
+ */
+mu_sched_wheel_t *mu_sched_wheel_init(mu_sched_wheel_t *wheel,
+                                      uint32_t ns_per_tick);
+
+/**
+ * @brief Returns the number of events held by the wheel.
+ */
+size_t mu_sched_wheel_count(const mu_sched_wheel_t *wheel);
+
+/**
+ * @brief Adds an event to the wheel.  O(1) unless the event is already due.
+ *
+ * The caller must have set evt->timestamp and evt->seq.
+ */
+void mu_sched_wheel_insert(mu_sched_wheel_t *wheel, mu_event_t *evt);
+
+/**
+ * @brief Moves every event whose tick is at or before `now` onto the sorted
+ * expiry list.  Does nothing if `now` is not later than the previous call.
+ */
+void mu_sched_wheel_advance(mu_sched_wheel_t *wheel, mu_time_abs_t now);
+
+/**
+ * @brief Returns the soonest expired event without removing it, or NULL.
+ *
+ * Only events moved by mu_sched_wheel_advance() are visible.  Because ticks
+ * may be coarser than timestamps, the caller must still compare the returned
+ * event's timestamp against the current time.
+ */
+mu_event_t *mu_sched_wheel_peek(const mu_sched_wheel_t *wheel);
+
+/**
+ * @brief Removes and returns the soonest expired event, or NULL.
+ */
+mu_event_t *mu_sched_wheel_pop(mu_sched_wheel_t *wheel);
+
+/**
+ * @brief Returns the soonest event held by the wheel, expired or not, without
+ * removing it.  Returns NULL if the wheel is empty.
+ *
+ * Only the lowest occupied slot (or the overflow list) is scanned, so this is
+ * proportional to the size of one slot rather than to the number of events.
+ */
+mu_event_t *mu_sched_wheel_earliest(const mu_sched_wheel_t *wheel);
+
+/**
+ * @brief Removes an event that is held by the wheel.  O(1).
+ */
+void mu_sched_wheel_remove(mu_sched_wheel_t *wheel, mu_event_t *evt);
+
+/**
+ * @brief Removes every event that refers to `thunk`.
+ *
+ * @return The removed events chained through their `next` fields, or NULL if
+ * none matched.  The caller owns the returned events.
+ */
+mu_event_t *mu_sched_wheel_remove_thunk(mu_sched_wheel_t *wheel,
+                                        mu_thunk_t *thunk);
+
+/**
+ * @brief Calls `fn` for every event held by the wheel, in no particular
+ * order.  Does not advance the wheel.
+ */
+void mu_sched_wheel_visit(const mu_sched_wheel_t *wheel, mu_event_visit_fn fn,
+                          void *ctx);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MU_SCHED_WHEEL_H */
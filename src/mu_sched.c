@@ -35,6 +35,11 @@
 #include "mu_pool.h"
 #include "mu_pqueue.h"
 #include "mu_pvec.h"
+#include "mu_sched_edf.h"
+#include "mu_sched_heap.h"
+#include "mu_sched_mpsc.h"
+#include "mu_sched_trace.h"
+#include "mu_sched_wheel.h"
 #include "mu_spsc.h"
 #include "mu_store.h"
 #include "mu_thunk.h"
@@ -42,41 +47,311 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#if !defined(__GNUC__)
+#include <stdatomic.h>
+#endif
+#ifdef MU_SCHED_STATS
+#include <string.h>
+#endif
 
 // *****************************************************************************
 // Private types and definitions
 
-/**
- * @brief Represents the scheduler instance.
- *
- * Contains pointers to the user-provided and already initialized queue and pool
- * instances. The user is responsible for declaring and initializing the actual
- * queue and pool structures and their backing memory, and passing pointers to
- * them during scheduler initialization.
- *
- * This struct is internal to the mu_sched implementation and not directly
- * exposed to the user API.
- */
-typedef struct mu_sched_t {
-    mu_spsc_t *interrupt_q; /**< Interrupt queue of mu_thunk_t* pointers */
-    mu_pqueue_t *asap_q;    /**< ASAP queue of mu_thunk_t* pointers */
-    mu_pvec_t *event_q;     /**< Event queue of mu_event_t* pointers */
-    mu_pool_t *event_pool;  /**< Pool for mu_event_t wrappers */
-    mu_thunk_t *idle_thunk; /**< Idle thunk to run when queues empty */
-    mu_time_abs_t (*get_time)(void); /**< Function to fetch current time */
-    mu_thunk_t *current_thunk;       /**< The thunk currently being executed */
-} mu_sched_t;
+// mu_event_t.flags bits
+#define EVENT_PENDING 0x01   /**< Event is held by the event store */
+#define EVENT_CANCELLED 0x02 /**< Event is a tombstone awaiting removal */
+#define EVENT_INTRUSIVE 0x04 /**< Event is caller-owned, not from the pool */
+
+// Atomic test-and-set / clear of mu_sched_once_t.queued.  The flag is a plain
+// byte in the public header so that it stays usable from C++.
+#if defined(__GNUC__)
+#define ONCE_TEST_AND_SET(flag) __atomic_test_and_set((flag), __ATOMIC_ACQ_REL)
+#define ONCE_CLEAR(flag) __atomic_clear((flag), __ATOMIC_RELEASE)
+#else
+#define ONCE_TEST_AND_SET(flag)                                                \
+    (atomic_exchange((_Atomic uint8_t *)(flag), 1) != 0)
+#define ONCE_CLEAR(flag) atomic_store((_Atomic uint8_t *)(flag), 0)
+#endif
+
+#ifdef MU_SCHED_TRACE
+#define TRACE_FROM(sched, type, context, thunk)                                \
+    do {                                                                       \
+        if ((sched)->trace) {                                                  \
+            mu_sched_trace_put_ctx((sched)->trace, (type), (context),          \
+                                   (thunk));                                   \
+        }                                                                      \
+    } while (0)
+#else
+#define TRACE_FROM(sched, type, context, thunk) ((void)0)
+#endif
+#define TRACE(sched, type, thunk)                                              \
+    TRACE_FROM(sched, type, MU_SCHED_TRACE_CTX_SCHED, thunk)
+
+/** State of a mu_sched_snapshot() pass over the event store. */
+typedef struct {
+    mu_sched_pending_t *pending; /**< The caller's array, soonest first */
+    size_t max_pending;          /**< Its length */
+    size_t count;                /**< Entries filled so far */
+    mu_time_abs_t now;           /**< Reference for tick timestamps */
+} snapshot_collector_t;
 
 // *****************************************************************************
 // Private data
 
+/** The default instance used by the non-_ex API. */
 static mu_sched_t s_sched;
-static bool s_sched_initialized = false;
 
 // *****************************************************************************
 // Private function prototypes
 
-static bool is_scheduler_initialized(void);
+static bool is_scheduler_initialized(mu_sched_t *sched);
+
+static void init_common(mu_sched_t *sched, mu_spsc_t *interrupt_q,
+                        mu_pqueue_t *asap_q, mu_pool_t *event_pool);
+
+/**
+ * @brief Returns an event to the pool (unless it is caller-owned), clearing
+ * its flags so that stale handles can no longer refer to it.
+ */
+static void free_event(mu_sched_t *sched, mu_event_t *evt);
+
+/**
+ * @brief Takes a wrapper from / returns a wrapper to the event pool, keeping
+ * count of the wrappers in use.
+ */
+static mu_event_t *alloc_event(mu_sched_t *sched);
+static void release_event(mu_sched_t *sched, mu_event_t *evt);
+
+/**
+ * @brief Gets the next item from the interrupt queue, keeping count of the
+ * items taken.
+ */
+static bool take_isr_item(mu_sched_t *sched, mu_thunk_t **item);
+
+/**
+ * @brief Calls `fn` for every event held by the event store, tombstones
+ * included.
+ */
+static void event_store_visit(mu_sched_t *sched, mu_event_visit_fn fn,
+                              void *ctx);
+
+/**
+ * @brief mu_event_visit_fn for mu_sched_snapshot(): keeps the soonest live
+ * events in a snapshot_collector_t, in order.
+ */
+static void collect_pending(const mu_event_t *evt, void *ctx);
+
+/**
+ * @brief Event store helpers.
+ *
+ * Dispatch to whichever event store (sorted mu_pvec or timer wheel) the
+ * scheduler was initialized with.  event_store_peek() returns the soonest
+ * event known to the store, and event_store_pop() removes that same event.
+ */
+static bool event_store_insert(mu_sched_t *sched, mu_event_t *evt);
+static void event_store_advance(mu_sched_t *sched, mu_time_abs_t now);
+static mu_event_t *event_store_peek(mu_sched_t *sched);
+static void event_store_pop(mu_sched_t *sched);
+static size_t event_store_count(const mu_sched_t *sched);
+
+/**
+ * @brief Batch helpers.
+ *
+ * event_store_room() is how many more events the store can take.
+ * sort_events() merge-sorts a list linked through `next`, soonest first, and
+ * event_store_merge() inserts such a list: for the mu_pvec in one linear
+ * merge at the soonest end, elsewhere one event at a time.  It returns false
+ * if the store ran out of room, which callers rule out beforehand.
+ */
+static size_t event_store_room(const mu_sched_t *sched);
+static mu_event_t *sort_events(mu_event_t *list);
+static bool event_store_merge(mu_sched_t *sched, mu_event_t *sorted);
+static void note_event_count(mu_sched_t *sched);
+
+/**
+ * @brief Removes an arbitrary event if the store supports it (timer wheel and
+ * heap).  Returns false for the mu_pvec, where callers leave a tombstone or
+ * search instead.
+ */
+static bool event_store_remove(mu_sched_t *sched, mu_event_t *evt);
+
+/**
+ * @brief Returns the soonest live (not cancelled) event without removing it,
+ * whether or not it has been made visible by event_store_advance().
+ */
+static mu_event_t *event_store_earliest(mu_sched_t *sched);
+
+/**
+ * @brief Queues a ready thunk on the EDF queue if one is attached, else on
+ * the asap_q.  `deadline` is ignored by the asap_q.
+ */
+static bool ready_put(mu_sched_t *sched, mu_thunk_t *thunk,
+                      mu_time_abs_t deadline);
+static bool ready_get(mu_sched_t *sched, mu_thunk_t **thunk, void **args);
+static bool ready_is_full(const mu_sched_t *sched);
+static bool ready_is_empty(const mu_sched_t *sched);
+static size_t ready_count(const mu_sched_t *sched);
+static size_t ready_room(const mu_sched_t *sched);
+
+/**
+ * @brief Queues a ready thunk, first evicting the oldest ready thunk if the
+ * queue is full and the overload policy is MU_SCHED_OVERLOAD_DROP_OLDEST.
+ */
+static bool ready_admit(mu_sched_t *sched, mu_thunk_t *thunk,
+                        mu_time_abs_t deadline);
+
+/**
+ * @brief Removes a thunk from the highest non-empty priority level.
+ */
+static bool prio_get(mu_sched_t *sched, mu_thunk_t **thunk);
+static unsigned msb32(uint32_t x);
+
+/**
+ * @brief Moves events due at or before `now` into the ready queue.  What
+ * happens when it is full depends on the overload policy.  Returns the number
+ * of thunks promoted.
+ */
+static size_t promote_due_events(mu_sched_t *sched, mu_time_abs_t now);
+
+/**
+ * @brief Lazy promotion: removes the earliest due event from the store,
+ * re-arming it if periodic, and returns its thunk.  Tombstones are discarded.
+ */
+static bool take_due_event(mu_sched_t *sched, mu_time_abs_t now,
+                           mu_thunk_t **thunk, void **args);
+
+/**
+ * @brief Returns true if a due event should run before the ready queue.
+ */
+static bool due_event_first(mu_sched_t *sched, mu_time_abs_t now);
+
+/**
+ * @brief Allocates an event and inserts it into the event store.
+ */
+static bool schedule_event(mu_sched_t *sched, mu_thunk_t *thunk,
+                           mu_time_abs_t timestamp, mu_time_rel_t period,
+                           void *args, mu_sched_handle_t *handle);
+
+/**
+ * @brief Message helpers.
+ *
+ * A ready thunk with an argument is queued as its event wrapper, tagged in
+ * the low bit so that it can share the ready queues with bare thunks.
+ * open_item() turns a ready queue item back into a thunk and argument,
+ * freeing the wrapper of a message.
+ */
+static mu_thunk_t *message_item(mu_event_t *evt);
+static bool is_message(const mu_thunk_t *item);
+static void open_item(mu_sched_t *sched, mu_thunk_t *item, mu_thunk_t **thunk,
+                      void **args);
+
+/**
+ * @brief Once node helpers.
+ *
+ * A posted once node is queued in place of its thunk, tagged in the second
+ * lowest bit.  open_item() marks the node as no longer queued.
+ */
+static mu_thunk_t *once_item(mu_sched_once_t *once);
+static bool is_once(const mu_thunk_t *item);
+
+/**
+ * @brief Fills in an event and inserts it into the event store.  On failure
+ * the event's flags are cleared.
+ */
+static bool insert_event(mu_sched_t *sched, mu_event_t *evt,
+                         mu_thunk_t *thunk, mu_time_abs_t timestamp,
+                         mu_time_rel_t period, uint8_t flags);
+
+/**
+ * @brief Removes an event, live or tombstone, from the event store without
+ * freeing it.  O(1) for the timer wheel, O(n) for the mu_pvec.
+ */
+static void unlink_event(mu_sched_t *sched, mu_event_t *evt);
+
+/**
+ * @brief Advances a periodic event to its first deadline after `now`.
+ */
+static void next_period(mu_event_t *evt, mu_time_abs_t now);
+
+/**
+ * @brief Returns the virtual time in simulation mode, else calls get_time.
+ */
+static mu_time_abs_t read_clock(mu_sched_t *sched);
+
+/**
+ * @brief Starts a pass: reads the clock afresh and caches the reading until
+ * release_clock(), which keeps it in coarse mode.
+ */
+static mu_time_abs_t hold_clock(mu_sched_t *sched);
+static void release_clock(mu_sched_t *sched);
+
+/**
+ * @brief In simulation mode with nothing ready, advances virtual time to the
+ * next event deadline, unless that lies after `*limit` (if non-NULL).
+ * Returns true and updates `*now` if time moved.
+ */
+static bool sim_jump(mu_sched_t *sched, mu_time_abs_t *now,
+                     const mu_time_abs_t *limit);
+
+/**
+ * @brief Picks a time in [earliest, earliest + slack] to share with other
+ * timers (see mu_sched_in_slack()).
+ */
+static mu_time_abs_t coalesce_time(mu_sched_t *sched, mu_time_abs_t earliest,
+                                   mu_time_rel_t slack);
+
+/**
+ * @brief Returns event time t as an absolute time, using `now` as reference.
+ */
+static mu_time_abs_t event_abs_time(mu_event_time_t t, mu_time_abs_t now);
+
+/**
+ * @brief Moves thunks posted from other threads into the asap_q, stopping when
+ * the asap_q is full.  Returns the number of thunks moved.
+ */
+static size_t drain_remote_queue(mu_sched_t *sched, mu_time_abs_t now);
+
+/**
+ * @brief Run helpers.
+ *
+ * Each fetches the next thunk from its source and runs it with current_thunk
+ * set, returning true if a thunk was run.  run_ready_thunk() also runs due
+ * events in place when lazy promotion is enabled.
+ */
+static bool run_interrupt_thunk(mu_sched_t *sched);
+static bool run_ready_thunk(mu_sched_t *sched, mu_time_abs_t now);
+static bool run_idle_thunk(mu_sched_t *sched);
+static void run_thunk(mu_sched_t *sched, mu_thunk_t *thunk, void *args);
+
+/**
+ * @brief Finds (or, if `create`, claims) the budget table entry for a thunk.
+ * Returns NULL if there is no table, no entry, or the table is full.
+ */
+static mu_sched_budget_t *budget_entry(mu_sched_t *sched,
+                                       const mu_thunk_t *thunk, bool create);
+
+/**
+ * @brief Reads the clock for budget timing, never from the coarse cache.
+ */
+static mu_time_abs_t read_live_clock(mu_sched_t *sched);
+
+#ifdef MU_SCHED_STATS
+/**
+ * @brief Statistics helpers.
+ *
+ * stats_entry() finds (or, if `create`, claims) the table entry for a thunk.
+ * stats_note_due() remembers when a promoted thunk was due, and
+ * stats_record_run() accounts for one completed run.
+ */
+static mu_sched_thunk_stats_t *stats_entry(mu_sched_t *sched,
+                                           const mu_thunk_t *thunk,
+                                           bool create);
+static void stats_note_due(mu_sched_t *sched, mu_thunk_t *thunk,
+                           mu_time_abs_t due);
+static void stats_record_run(mu_sched_t *sched, mu_thunk_t *thunk,
+                             mu_time_abs_t start, mu_time_abs_t end);
+static size_t stats_lag_bucket(mu_time_rel_t lag);
+#endif
 
 /**
  * @brief Comparison function for scheduling events.
@@ -96,207 +371,2075 @@ static int compare_events(const void *a, const void *b);
 // *****************************************************************************
 // Public function implementations
 
-bool mu_sched_init(mu_spsc_t *interrupt_q, mu_pqueue_t *asap_q,
-                   mu_pvec_t *event_q, mu_pool_t *event_pool) {
-    if (!interrupt_q || !asap_q || !event_q || !event_pool) {
-        s_sched_initialized = false;
+bool mu_sched_init_ex(mu_sched_t *sched, mu_spsc_t *interrupt_q,
+                      mu_pqueue_t *asap_q, mu_pvec_t *event_q,
+                      mu_pool_t *event_pool) {
+    if (!sched) {
+        return false;
+    }
+    if (!interrupt_q || !asap_q || !event_q) {
+        sched->initialized = false;
         return false;
     }
 
-    s_sched.interrupt_q = interrupt_q;
-    s_sched.asap_q = asap_q;
-    s_sched.event_q = event_q;
-    s_sched.event_pool = event_pool;
-    s_sched.idle_thunk = NULL;
-    s_sched.current_thunk = NULL;
-    s_sched.get_time = mu_time_now; // Default time source
-    s_sched_initialized = true;
+    init_common(sched, interrupt_q, asap_q, event_pool);
+    sched->event_q = event_q;
+    sched->event_wheel = NULL;
+    sched->event_heap = NULL;
+    sched->initialized = true;
     return true;
 }
 
-bool mu_sched_now(mu_thunk_t *thunk) {
-    if (!is_scheduler_initialized() || !thunk) {
+bool mu_sched_init_wheel_ex(mu_sched_t *sched, mu_spsc_t *interrupt_q,
+                            mu_pqueue_t *asap_q, mu_sched_wheel_t *event_wheel,
+                            mu_pool_t *event_pool) {
+    if (!sched) {
+        return false;
+    }
+    if (!interrupt_q || !asap_q || !event_wheel) {
+        sched->initialized = false;
         return false;
     }
-    return mu_pqueue_put(s_sched.asap_q, thunk) == MU_STORE_ERR_NONE;
+#if defined(MU_SCHED_TICK_EVENTS) && MU_SCHED_TICK_BITS < 64
+    // The wheel needs monotonic timestamps; a 32-bit tick count wraps
+    sched->initialized = false;
+    return false;
+#endif
+
+    init_common(sched, interrupt_q, asap_q, event_pool);
+    sched->event_q = NULL;
+    sched->event_wheel = event_wheel;
+    sched->event_heap = NULL;
+    sched->initialized = true;
+    return true;
 }
 
-bool mu_sched_at(mu_thunk_t *thunk, mu_time_abs_t timestamp) {
-    if (!is_scheduler_initialized() || !thunk) {
+bool mu_sched_init_heap_ex(mu_sched_t *sched, mu_spsc_t *interrupt_q,
+                           mu_pqueue_t *asap_q, mu_sched_heap_t *event_heap,
+                           mu_pool_t *event_pool) {
+    if (!sched) {
         return false;
     }
-    mu_event_t *evt = mu_pool_alloc(s_sched.event_pool);
-    if (!evt) {
+    if (!interrupt_q || !asap_q || !event_heap) {
+        sched->initialized = false;
         return false;
     }
-    evt->thunk = thunk;
-    evt->timestamp = timestamp;
-    if (mu_pvec_sorted_insert(s_sched.event_q, evt, compare_events,
-                              MU_STORE_INSERT_FIRST) != MU_STORE_ERR_NONE) {
-        mu_pool_free(s_sched.event_pool, evt);
+
+    init_common(sched, interrupt_q, asap_q, event_pool);
+    sched->event_q = NULL;
+    sched->event_wheel = NULL;
+    sched->event_heap = event_heap;
+    sched->initialized = true;
+    return true;
+}
+
+bool mu_sched_now_ex(mu_sched_t *sched, mu_thunk_t *thunk) {
+    if (!is_scheduler_initialized(sched) || !thunk) {
+        return false;
+    }
+    // Only the EDF queue needs to know when the thunk became ready
+    mu_time_abs_t now = sched->edf_q ? read_clock(sched) : (mu_time_abs_t){0};
+    if (!ready_admit(sched, thunk, now)) {
+        sched->overload.rejected++;
         return false;
     }
+    TRACE(sched, MU_SCHED_TRACE_NOW, thunk);
     return true;
 }
 
-bool mu_sched_in(mu_thunk_t *thunk, mu_time_rel_t delay) {
-    if (!is_scheduler_initialized() || !thunk) {
+bool mu_sched_now_deadline_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                              mu_time_abs_t deadline) {
+    if (!is_scheduler_initialized(sched) || !thunk) {
+        return false;
+    }
+    if (!ready_admit(sched, thunk, deadline)) {
+        sched->overload.rejected++;
+        return false;
+    }
+    TRACE(sched, MU_SCHED_TRACE_NOW, thunk);
+    return true;
+}
+
+mu_sched_once_t *mu_sched_once_init(mu_sched_once_t *once, mu_thunk_t *thunk) {
+    if (!once || !thunk) {
+        return NULL;
+    }
+    once->thunk = thunk;
+    ONCE_CLEAR(&once->queued);
+    return once;
+}
+
+bool mu_sched_now_once_ex(mu_sched_t *sched, mu_sched_once_t *once) {
+    if (!is_scheduler_initialized(sched) || !once || !once->thunk) {
         return false;
     }
-    mu_time_abs_t now = s_sched.get_time();
-    return mu_sched_at(thunk, mu_time_offset(now, delay));
+    if (ONCE_TEST_AND_SET(&once->queued)) {
+        return true; // still queued
+    }
+    mu_time_abs_t now = sched->edf_q ? read_clock(sched) : (mu_time_abs_t){0};
+    if (!ready_admit(sched, once_item(once), now)) {
+        ONCE_CLEAR(&once->queued);
+        sched->overload.rejected++;
+        return false;
+    }
+    TRACE(sched, MU_SCHED_TRACE_NOW, once->thunk);
+    return true;
 }
 
-bool mu_sched_from_isr(mu_thunk_t *thunk) {
-    if (!s_sched_initialized || !thunk) {
+bool mu_sched_now_args_ex(mu_sched_t *sched, mu_thunk_t *thunk, void *args) {
+    if (!args) {
+        return mu_sched_now_ex(sched, thunk);
+    }
+    if (!is_scheduler_initialized(sched) || !thunk || !sched->event_pool) {
         return false;
     }
-    return mu_spsc_put(s_sched.interrupt_q, thunk) == MU_SPSC_ERR_NONE;
+    mu_event_t *evt = alloc_event(sched);
+    mu_time_abs_t now = sched->edf_q ? read_clock(sched) : (mu_time_abs_t){0};
+    if (evt) {
+        evt->thunk = thunk;
+        evt->args = args;
+        evt->flags = 0;
+        if (ready_admit(sched, message_item(evt), now)) {
+            TRACE(sched, MU_SCHED_TRACE_NOW, thunk);
+            return true;
+        }
+        release_event(sched, evt);
+    }
+    sched->overload.rejected++;
+    return false;
 }
 
-int mu_sched_delete_thunk_events(mu_thunk_t *thunk) {
-    if (!is_scheduler_initialized() || thunk == NULL) {
-        return 0;
+bool mu_sched_now_many_ex(mu_sched_t *sched, mu_thunk_t *const *thunks,
+                          size_t n) {
+    if (!is_scheduler_initialized(sched) || !thunks) {
+        return false;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (!thunks[i]) {
+            return false;
+        }
+    }
+    if (ready_room(sched) < n) {
+        sched->overload.rejected++;
+        return false;
+    }
+    mu_time_abs_t now = sched->edf_q ? read_clock(sched) : (mu_time_abs_t){0};
+    for (size_t i = 0; i < n; i++) {
+        ready_put(sched, thunks[i], now);
+        TRACE(sched, MU_SCHED_TRACE_NOW, thunks[i]);
     }
+    return true;
+}
 
-    int removed = 0;
-    mu_event_t *evt;
-    /* Iterate by index; when we delete at i, the next element shifts into i,
-     * so only increment i when we don’t delete. */
-    size_t i = 0;
-    while (i < mu_pvec_count(s_sched.event_q)) {
-        if (mu_pvec_ref(s_sched.event_q, i, (void **)&evt) !=
-            MU_STORE_ERR_NONE) {
-            break; // something’s wrong—abort
+bool mu_sched_at_many_ex(mu_sched_t *sched, mu_thunk_t *const *thunks,
+                         const mu_time_abs_t *timestamps, size_t n) {
+    mu_event_t *batch = NULL;
+
+    if (!is_scheduler_initialized(sched) || !thunks || !timestamps ||
+        !sched->event_pool) {
+        return false;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (!thunks[i]) {
+            return false;
         }
+    }
+    if (event_store_room(sched) < n) {
+        return false;
+    }
 
-        if (evt->thunk == thunk) {
-            /* remove that wrapper from the vector */
-            mu_pvec_delete(s_sched.event_q, i, (void **)&evt);
-            /* return it to the pool */
-            mu_pool_free(s_sched.event_pool, evt);
-            removed++;
-            /* do not advance i, since the next event has shifted into slot i */
-        } else {
-            i++;
+    // Reserve every wrapper before touching the store: all or nothing
+    for (size_t i = n; i-- > 0;) {
+        mu_event_t *evt = alloc_event(sched);
+        if (!evt) {
+            while (batch) {
+                evt = batch;
+                batch = batch->next;
+                release_event(sched, evt);
+            }
+            return false;
         }
+        evt->thunk = thunks[i];
+        evt->timestamp = mu_event_time_of(timestamps[i]);
+        evt->period = 0;
+        evt->seq = sched->event_seq + (uint32_t)i;
+        evt->flags = EVENT_PENDING;
+        evt->next = batch;
+        batch = evt;
     }
+    sched->event_seq += (uint32_t)n;
 
-    return removed;
+    bool merged = event_store_merge(sched, sort_events(batch));
+    note_event_count(sched);
+    if (!merged) {
+        return false; // only if the room check above was wrong
+    }
+    for (size_t i = 0; i < n; i++) {
+        TRACE(sched, MU_SCHED_TRACE_AT, thunks[i]);
+    }
+    return true;
 }
 
-void mu_sched_set_idle_thunk(mu_thunk_t *idle) {
-    if (!is_scheduler_initialized()) {
-        return;
+bool mu_sched_at_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                    mu_time_abs_t timestamp) {
+    return mu_sched_at_handle_ex(sched, thunk, timestamp, NULL);
+}
+
+bool mu_sched_at_args_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                         mu_time_abs_t timestamp, void *args) {
+    if (!is_scheduler_initialized(sched) || !thunk) {
+        return false;
     }
-    s_sched.idle_thunk = idle;
+    return schedule_event(sched, thunk, timestamp, 0, args, NULL);
 }
 
-void mu_sched_set_time_fn(mu_time_abs_t (*fn)(void)) {
-    if (!is_scheduler_initialized()) {
-        return;
+bool mu_sched_in_ex(mu_sched_t *sched, mu_thunk_t *thunk, mu_time_rel_t delay) {
+    return mu_sched_in_handle_ex(sched, thunk, delay, NULL);
+}
+
+bool mu_sched_at_handle_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                           mu_time_abs_t timestamp, mu_sched_handle_t *handle) {
+    if (!is_scheduler_initialized(sched) || !thunk) {
+        return false;
     }
-    s_sched.get_time = fn ? fn : mu_time_now;
+    return schedule_event(sched, thunk, timestamp, 0, NULL, handle);
 }
 
-/**
- * @brief Performs one scheduling pass: processes interrupts, due timed events,
- *        then executes the next thunk (or idle thunk). Prevents recursion by
- *        returning immediately if already in a step.
- */
-void mu_sched_step(void) {
-    if (!is_scheduler_initialized()) {
-        return;
+bool mu_sched_in_handle_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                           mu_time_rel_t delay, mu_sched_handle_t *handle) {
+    if (!is_scheduler_initialized(sched) || !thunk) {
+        return false;
     }
+    mu_time_abs_t now = read_clock(sched);
+    return mu_sched_at_handle_ex(sched, thunk, mu_time_offset(now, delay),
+                                 handle);
+}
 
-    /* Prevent recursive scheduling if inside a thunk */
-    if (s_sched.current_thunk != NULL) {
-        return;
+bool mu_sched_in_slack_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                          mu_time_rel_t delay, mu_time_rel_t slack,
+                          mu_sched_handle_t *handle) {
+    if (!is_scheduler_initialized(sched) || !thunk || slack < 0) {
+        return false;
     }
+    mu_time_abs_t earliest = mu_time_offset(read_clock(sched), delay);
+    return mu_sched_at_handle_ex(sched, thunk,
+                                 coalesce_time(sched, earliest, slack), handle);
+}
 
-    /* Clear any previous thunk marker */
-    s_sched.current_thunk = NULL;
+bool mu_sched_every_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                       mu_time_rel_t period) {
+    return mu_sched_every_handle_ex(sched, thunk, period, NULL);
+}
 
-    // 1) ISR has top priority: if there's an ISR thunk, run it now and return
-    mu_spsc_item_t isr_item;
-    if (mu_spsc_get(s_sched.interrupt_q, &isr_item) == MU_SPSC_ERR_NONE) {
-        s_sched.current_thunk = (mu_thunk_t *)isr_item;
-        mu_thunk_call(s_sched.current_thunk, NULL);
-        s_sched.current_thunk = NULL;
-        return;
+bool mu_sched_every_handle_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                              mu_time_rel_t period, mu_sched_handle_t *handle) {
+    if (!is_scheduler_initialized(sched) || !thunk || period <= 0) {
+        return false;
     }
+#ifdef MU_SCHED_TICK_EVENTS
+    if (period < MU_SCHED_TICK_NS) {
+        return false; // would not advance the tick count
+    }
+#endif
+    mu_time_abs_t first = mu_time_offset(read_clock(sched), period);
+    return schedule_event(sched, thunk, first, period, NULL, handle);
+}
 
-    /* 2) Move due timed events into ASAP queue */
-    mu_event_t *evt;
-    mu_time_abs_t now = s_sched.get_time();
-    while (!mu_pqueue_is_full(s_sched.asap_q) &&
-           mu_pvec_peek(s_sched.event_q, (void **)&evt) == MU_STORE_ERR_NONE &&
-           !mu_time_is_after(evt->timestamp, now)) {
-
-        if (mu_pvec_pop(s_sched.event_q, (void **)&evt) != MU_STORE_ERR_NONE) {
-            /* Should not happen: peek succeeded but pop failed */
-            break;
-        }
+bool mu_sched_at_event_ex(mu_sched_t *sched, mu_event_t *evt,
+                          mu_thunk_t *thunk, mu_time_abs_t timestamp) {
+    if (!is_scheduler_initialized(sched) || !evt || !thunk) {
+        return false;
+    }
+    if (evt->flags & EVENT_PENDING) {
+        unlink_event(sched, evt); // re-arm
+    }
+    if (!insert_event(sched, evt, thunk, timestamp, 0,
+                      EVENT_PENDING | EVENT_INTRUSIVE)) {
+        return false;
+    }
+    TRACE(sched, MU_SCHED_TRACE_AT, thunk);
+    return true;
+}
 
-        if (mu_pqueue_put(s_sched.asap_q, evt->thunk) != MU_STORE_ERR_NONE) {
-            /* ASAP queue full: free wrapper and stop */
-            mu_pool_free(s_sched.event_pool, evt);
-            break;
-        }
+bool mu_sched_in_event_ex(mu_sched_t *sched, mu_event_t *evt,
+                          mu_thunk_t *thunk, mu_time_rel_t delay) {
+    if (!is_scheduler_initialized(sched)) {
+        return false;
+    }
+    return mu_sched_at_event_ex(sched, evt, thunk,
+                                mu_time_offset(read_clock(sched), delay));
+}
 
-        /* Free the event wrapper now that its thunk is enqueued */
-        mu_pool_free(s_sched.event_pool, evt);
+bool mu_sched_cancel_event_ex(mu_sched_t *sched, mu_event_t *evt) {
+    if (!is_scheduler_initialized(sched) || !evt ||
+        (evt->flags & (EVENT_PENDING | EVENT_INTRUSIVE)) !=
+            (EVENT_PENDING | EVENT_INTRUSIVE)) {
+        return false;
     }
+    TRACE(sched, MU_SCHED_TRACE_CANCEL, evt->thunk);
+    unlink_event(sched, evt);
+    evt->flags = 0;
+    return true;
+}
 
-    /* 3) Execute next available thunk, or idle if none */
-    mu_thunk_t *thunk_ptr;
-    if (mu_pqueue_get(s_sched.asap_q, (void **)&thunk_ptr) ==
-        MU_STORE_ERR_NONE) {
-        s_sched.current_thunk = thunk_ptr;
-        mu_thunk_call(thunk_ptr, NULL);
-        s_sched.current_thunk = NULL;
-    } else if (s_sched.idle_thunk) {
-        s_sched.current_thunk = s_sched.idle_thunk;
-        mu_thunk_call(s_sched.idle_thunk, NULL);
-        s_sched.current_thunk = NULL;
+bool mu_sched_cancel_ex(mu_sched_t *sched, mu_sched_handle_t *handle) {
+    if (!is_scheduler_initialized(sched) || !handle || !handle->event) {
+        return false;
     }
+    mu_event_t *evt = handle->event;
+    handle->event = NULL;
+    if (evt->seq != handle->seq ||
+        (evt->flags & ~EVENT_INTRUSIVE) != EVENT_PENDING) {
+        // Already ran, already cancelled, or recycled for another event.
+        return false;
+    }
+    TRACE(sched, MU_SCHED_TRACE_CANCEL, evt->thunk);
+    if (event_store_remove(sched, evt)) {
+        free_event(sched, evt);
+    } else {
+        // Leave a tombstone: mu_sched_step() frees it when it surfaces.
+        evt->flags |= EVENT_CANCELLED;
+    }
+    return true;
 }
 
-bool mu_sched_has_runnable_thunk(void) {
-    if (!is_scheduler_initialized()) {
+bool mu_sched_from_isr_ex(mu_sched_t *sched, mu_thunk_t *thunk) {
+    if (!is_scheduler_initialized(sched) || !thunk) {
         return false;
     }
-    // We don't check the spsc_q because (A) there's no interrupt safe
-    // mu_spsc_is_empty() function and (B) an interrupt could happen
-    // any time, so we assume any events from spsc_q have already been
-    // move to the asap_q.
-    return !mu_pqueue_is_empty(s_sched.asap_q);
+    // Count before publishing, so the consumer never takes an uncounted item
+    sched->isr_posts++;
+    if (mu_spsc_put(sched->interrupt_q, thunk) != MU_SPSC_ERR_NONE) {
+        sched->isr_posts--;
+        return false;
+    }
+    TRACE_FROM(sched, MU_SCHED_TRACE_ISR, MU_SCHED_TRACE_CTX_ISR, thunk);
+    return true;
 }
 
-const mu_thunk_t *mu_sched_current_thunk(void) {
-    if (!is_scheduler_initialized()) {
-        return NULL;
+bool mu_sched_from_isr_once_ex(mu_sched_t *sched, mu_sched_once_t *once) {
+    if (!is_scheduler_initialized(sched) || !once || !once->thunk) {
+        return false;
+    }
+    if (ONCE_TEST_AND_SET(&once->queued)) {
+        return true; // still queued
     }
-    return s_sched.current_thunk;
+    sched->isr_posts++;
+    if (mu_spsc_put(sched->interrupt_q, once_item(once)) != MU_SPSC_ERR_NONE) {
+        sched->isr_posts--;
+        ONCE_CLEAR(&once->queued);
+        return false;
+    }
+    TRACE_FROM(sched, MU_SCHED_TRACE_ISR, MU_SCHED_TRACE_CTX_ISR,
+               once->thunk);
+    return true;
 }
 
-mu_time_abs_t mu_sched_current_time(void) {
-    if (!is_scheduler_initialized()) {
-        // If someone calls this before init, fall back to the default
-        return mu_time_now();
+bool mu_sched_from_isr_args_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                               void *args) {
+    // The remote queue is drained into pool wrappers, hence the pool check
+    if (!is_scheduler_initialized(sched) || !sched->remote_q || !thunk ||
+        !sched->event_pool) {
+        return false;
+    }
+    if (mu_sched_mpsc_put_args(sched->remote_q, thunk, args) !=
+        MU_SCHED_MPSC_ERR_NONE) {
+        return false;
     }
-    return s_sched.get_time();
+    TRACE_FROM(sched, MU_SCHED_TRACE_ISR, MU_SCHED_TRACE_CTX_ISR, thunk);
+    return true;
 }
 
-static bool is_scheduler_initialized(void) { return s_sched_initialized; }
+bool mu_sched_now_prio_ex(mu_sched_t *sched, mu_thunk_t *thunk,
+                          unsigned level) {
+    if (!is_scheduler_initialized(sched) || !thunk ||
+        level >= MU_SCHED_PRIO_LEVELS || !sched->prio_q[level]) {
+        return false;
+    }
+    if (mu_pqueue_put(sched->prio_q[level], thunk) != MU_STORE_ERR_NONE) {
+        sched->overload.rejected++;
+        return false;
+    }
+    sched->prio_ready |= 1u << level;
+    TRACE(sched, MU_SCHED_TRACE_NOW, thunk);
+    return true;
+}
+
+bool mu_sched_set_prio_queue_ex(mu_sched_t *sched, unsigned level,
+                                mu_pqueue_t *prio_q) {
+    if (!is_scheduler_initialized(sched) || level >= MU_SCHED_PRIO_LEVELS) {
+        return false;
+    }
+    sched->prio_q[level] = prio_q;
+    if (prio_q && !mu_pqueue_is_empty(prio_q)) {
+        sched->prio_ready |= 1u << level;
+    } else {
+        sched->prio_ready &= ~(1u << level);
+    }
+    return true;
+}
+
+void mu_sched_set_overload_policy_ex(mu_sched_t *sched,
+                                     mu_sched_overload_t policy) {
+    if (!is_scheduler_initialized(sched)) {
+        return;
+    }
+    sched->overload_policy = policy;
+}
+
+const mu_sched_overload_stats_t *
+mu_sched_overload_stats_ex(mu_sched_t *sched) {
+    if (!is_scheduler_initialized(sched)) {
+        return NULL;
+    }
+    return &sched->overload;
+}
+
+void mu_sched_overload_stats_reset_ex(mu_sched_t *sched) {
+    if (!is_scheduler_initialized(sched)) {
+        return;
+    }
+    sched->overload = (mu_sched_overload_stats_t){0};
+}
+
+void mu_sched_set_lazy_promotion_ex(mu_sched_t *sched, bool enabled) {
+    if (!is_scheduler_initialized(sched)) {
+        return;
+    }
+    sched->lazy_promotion = enabled;
+}
+
+void mu_sched_set_edf_queue_ex(mu_sched_t *sched, mu_sched_edf_t *edf_q) {
+    if (!is_scheduler_initialized(sched)) {
+        return;
+    }
+    sched->edf_q = edf_q;
+}
+
+void mu_sched_set_remote_queue_ex(mu_sched_t *sched,
+                                  struct mu_sched_mpsc *remote_q) {
+    if (!is_scheduler_initialized(sched)) {
+        return;
+    }
+    sched->remote_q = remote_q;
+}
+
+bool mu_sched_post_remote_ex(mu_sched_t *sched, mu_thunk_t *thunk) {
+    if (!is_scheduler_initialized(sched) || !sched->remote_q || !thunk) {
+        return false;
+    }
+    if (mu_sched_mpsc_put(sched->remote_q, thunk) != MU_SCHED_MPSC_ERR_NONE) {
+        return false;
+    }
+    TRACE_FROM(sched, MU_SCHED_TRACE_REMOTE, MU_SCHED_TRACE_CTX_REMOTE,
+               thunk);
+    return true;
+}
+
+int mu_sched_delete_thunk_events_ex(mu_sched_t *sched, mu_thunk_t *thunk) {
+    if (!is_scheduler_initialized(sched) || thunk == NULL) {
+        return 0;
+    }
+
+    int removed = 0;
+    mu_event_t *evt;
+
+    if (!sched->event_q) {
+        evt = sched->event_wheel
+                  ? mu_sched_wheel_remove_thunk(sched->event_wheel, thunk)
+                  : mu_sched_heap_remove_thunk(sched->event_heap, thunk);
+        while (evt) {
+            mu_event_t *next = evt->next;
+            free_event(sched, evt);
+            removed++;
+            evt = next;
+        }
+        return removed;
+    }
+
+    /* Iterate by index; when we delete at i, the next element shifts into i,
+     * so only increment i when we don’t delete. */
+    size_t i = 0;
+    while (i < mu_pvec_count(sched->event_q)) {
+        if (mu_pvec_ref(sched->event_q, i, (void **)&evt) !=
+            MU_STORE_ERR_NONE) {
+            break; // something’s wrong—abort
+        }
+
+        if (evt->thunk == thunk) {
+            /* remove that wrapper from the vector */
+            mu_pvec_delete(sched->event_q, i, (void **)&evt);
+            /* cancelled events were already accounted for */
+            if (!(evt->flags & EVENT_CANCELLED)) {
+                removed++;
+            }
+            /* return it to the pool */
+            free_event(sched, evt);
+            /* do not advance i, since the next event has shifted into slot i */
+        } else {
+            i++;
+        }
+    }
+
+    return removed;
+}
+
+void mu_sched_set_idle_thunk_ex(mu_sched_t *sched, mu_thunk_t *idle) {
+    if (!is_scheduler_initialized(sched)) {
+        return;
+    }
+    sched->idle_thunk = idle;
+}
+
+void mu_sched_set_time_fn_ex(mu_sched_t *sched, mu_time_abs_t (*fn)(void)) {
+    if (!is_scheduler_initialized(sched)) {
+        return;
+    }
+    sched->get_time = fn ? fn : mu_time_now;
+    sched->clock_cached = false;
+}
+
+void mu_sched_set_coarse_clock_ex(mu_sched_t *sched, bool enabled) {
+    if (!is_scheduler_initialized(sched)) {
+        return;
+    }
+    sched->coarse_clock = enabled;
+    sched->clock_cached = false;
+}
+
+/**
+ * @brief Performs one scheduling pass: processes interrupts, due timed events,
+ *        then executes the next thunk (or idle thunk). Prevents recursion by
+ *        returning immediately if already in a step.
+ */
+void mu_sched_step_ex(mu_sched_t *sched) {
+    if (!is_scheduler_initialized(sched)) {
+        return;
+    }
+
+    /* Prevent recursive scheduling if inside a thunk */
+    if (sched->current_thunk != NULL) {
+        return;
+    }
+
+    /* A new pass: even in coarse mode the next read goes to the clock */
+    sched->clock_cached = false;
+
+    // 1) ISR has top priority: if there's an ISR thunk, run it now and return
+    if (run_interrupt_thunk(sched)) {
+        release_clock(sched);
+        return;
+    }
+
+    /* 2) Move thunks posted by other threads, then due timed events, into
+     * the ASAP queue */
+    mu_time_abs_t now = hold_clock(sched);
+    drain_remote_queue(sched, now);
+    promote_due_events(sched, now);
+
+    /* In simulation mode, skip straight to the next deadline if idle */
+    if (sim_jump(sched, &now, NULL)) {
+        promote_due_events(sched, now);
+    }
+
+    /* 3) Execute next available thunk, or idle if none */
+    if (!run_ready_thunk(sched, now)) {
+        run_idle_thunk(sched);
+    }
+    release_clock(sched);
+}
+
+size_t mu_sched_step_n_ex(mu_sched_t *sched, size_t max_thunks) {
+    if (!is_scheduler_initialized(sched) || sched->current_thunk != NULL) {
+        return 0;
+    }
+
+    /* Read the clock once for the whole batch */
+    mu_time_abs_t now = hold_clock(sched);
+    size_t ran = 0;
+
+    drain_remote_queue(sched, now);
+    promote_due_events(sched, now);
+    while (ran < max_thunks) {
+        if (run_interrupt_thunk(sched) || run_ready_thunk(sched, now)) {
+            ran++;
+        } else if (drain_remote_queue(sched, now) == 0 &&
+                   promote_due_events(sched, now) == 0 &&
+                   !sim_jump(sched, &now, NULL)) {
+            /* Nothing left that is runnable as of `now` */
+            break;
+        }
+    }
+
+    if (ran == 0) {
+        run_idle_thunk(sched);
+    }
+    release_clock(sched);
+    return ran;
+}
+
+void mu_sched_sim_start_ex(mu_sched_t *sched, mu_time_abs_t start) {
+    if (!is_scheduler_initialized(sched)) {
+        return;
+    }
+    sched->sim_time = start;
+    sched->simulated = true;
+}
+
+void mu_sched_sim_stop_ex(mu_sched_t *sched) {
+    if (!is_scheduler_initialized(sched)) {
+        return;
+    }
+    sched->simulated = false;
+    sched->clock_cached = false;
+}
+
+void mu_sched_sim_advance_ex(mu_sched_t *sched, mu_time_rel_t dt) {
+    if (!is_scheduler_initialized(sched) || !sched->simulated || dt <= 0) {
+        return;
+    }
+    sched->sim_time = mu_time_offset(sched->sim_time, dt);
+}
+
+size_t mu_sched_sim_run_until_ex(mu_sched_t *sched, mu_time_abs_t end) {
+    size_t ran = 0;
+
+    if (!is_scheduler_initialized(sched) || !sched->simulated ||
+        sched->current_thunk != NULL) {
+        return 0;
+    }
+    for (;;) {
+        mu_time_abs_t now = sched->sim_time;
+        drain_remote_queue(sched, now);
+        promote_due_events(sched, now);
+        if (run_interrupt_thunk(sched) || run_ready_thunk(sched, now)) {
+            ran++;
+        } else if (!sim_jump(sched, &now, &end)) {
+            break;
+        }
+    }
+    if (mu_time_is_after(end, sched->sim_time)) {
+        sched->sim_time = end;
+    }
+    return ran;
+}
+
+bool mu_sched_take_ready_ex(mu_sched_t *sched, mu_thunk_t **thunk) {
+    void *args;
+    return mu_sched_take_ready_args_ex(sched, thunk, &args);
+}
+
+bool mu_sched_take_ready_args_ex(mu_sched_t *sched, mu_thunk_t **thunk,
+                                 void **args) {
+    mu_thunk_t *isr_item;
+
+    if (!is_scheduler_initialized(sched) || !thunk || !args) {
+        return false;
+    }
+    if (take_isr_item(sched, &isr_item)) {
+        open_item(sched, isr_item, thunk, args);
+        return true;
+    }
+    mu_time_abs_t now = hold_clock(sched);
+    drain_remote_queue(sched, now);
+    promote_due_events(sched, now);
+    bool taken = (due_event_first(sched, now) &&
+                  take_due_event(sched, now, thunk, args)) ||
+                 ready_get(sched, thunk, args) ||
+                 take_due_event(sched, now, thunk, args);
+    release_clock(sched);
+    return taken;
+}
+
+void mu_sched_run_ex(mu_sched_t *sched, mu_thunk_t *thunk) {
+    mu_sched_run_args_ex(sched, thunk, NULL);
+}
+
+void mu_sched_run_args_ex(mu_sched_t *sched, mu_thunk_t *thunk, void *args) {
+    if (!is_scheduler_initialized(sched) || !thunk ||
+        sched->current_thunk != NULL) {
+        return;
+    }
+    run_thunk(sched, thunk, args);
+}
+
+bool mu_sched_has_runnable_thunk_ex(mu_sched_t *sched) {
+    if (!is_scheduler_initialized(sched)) {
+        return false;
+    }
+    // We don't check the spsc_q because (A) there's no interrupt safe
+    // mu_spsc_is_empty() function and (B) an interrupt could happen
+    // any time, so we assume any events from spsc_q have already been
+    // move to the asap_q.
+    if (sched->remote_q && !mu_sched_mpsc_is_empty(sched->remote_q)) {
+        return true;
+    }
+    return !ready_is_empty(sched);
+}
+
+bool mu_sched_snapshot_ex(mu_sched_t *sched, mu_sched_snapshot_t *snap,
+                          mu_sched_pending_t *pending, size_t max_pending) {
+    if (!is_scheduler_initialized(sched) || !snap ||
+        (!pending && max_pending > 0)) {
+        return false;
+    }
+    size_t ready = ready_count(sched);
+    size_t ready_capacity = ready + ready_room(sched);
+    for (unsigned level = 0; level < MU_SCHED_PRIO_LEVELS; level++) {
+        if (sched->prio_q[level]) {
+            ready += mu_pqueue_count(sched->prio_q[level]);
+            ready_capacity += mu_pqueue_capacity(sched->prio_q[level]);
+        }
+    }
+    size_t event_count = event_store_count(sched);
+    size_t event_room = event_store_room(sched);
+
+    snap->isr_count = (uint32_t)(sched->isr_posts - sched->isr_takes);
+    snap->ready_count = ready;
+    snap->ready_capacity = ready_capacity;
+    snap->event_count = event_count;
+    snap->event_capacity =
+        event_room == SIZE_MAX ? SIZE_MAX : event_count + event_room;
+    snap->pool_in_use = sched->pool_in_use;
+    snap->remote_pending =
+        sched->remote_q && !mu_sched_mpsc_is_empty(sched->remote_q);
+    snap->overload = sched->overload;
+    if (snap->isr_count > snap->overload.isr_hwm) {
+        snap->overload.isr_hwm = snap->isr_count;
+    }
+
+    snapshot_collector_t collector = {pending, max_pending, 0,
+                                      read_live_clock(sched)};
+    if (max_pending > 0) {
+        event_store_visit(sched, collect_pending, &collector);
+    }
+    snap->pending_count = collector.count;
+    return true;
+}
+
+bool mu_sched_next_deadline_ex(mu_sched_t *sched, mu_time_abs_t *out) {
+    if (!is_scheduler_initialized(sched) || !out) {
+        return false;
+    }
+    mu_event_t *evt = event_store_earliest(sched);
+    if (!evt) {
+        return false;
+    }
+    *out = event_abs_time(evt->timestamp, read_clock(sched));
+    return true;
+}
+
+bool mu_sched_idle_timeout_ex(mu_sched_t *sched, mu_time_rel_t *timeout) {
+    if (!is_scheduler_initialized(sched) || !timeout) {
+        return false;
+    }
+    if (mu_sched_has_runnable_thunk_ex(sched)) {
+        *timeout = 0;
+        return true;
+    }
+    mu_time_abs_t deadline;
+    if (!mu_sched_next_deadline_ex(sched, &deadline)) {
+        return false;
+    }
+    // About to sleep on the result: don't trust a coarse reading
+    mu_time_abs_t now = hold_clock(sched);
+    release_clock(sched);
+    *timeout = mu_time_is_after(deadline, now)
+                   ? mu_time_difference(deadline, now)
+                   : 0;
+    return true;
+}
+
+const mu_thunk_t *mu_sched_current_thunk_ex(mu_sched_t *sched) {
+    if (!is_scheduler_initialized(sched)) {
+        return NULL;
+    }
+    return sched->current_thunk;
+}
+
+bool mu_sched_set_budget_table_ex(mu_sched_t *sched, mu_sched_budget_t *table,
+                                  size_t capacity) {
+    if (!is_scheduler_initialized(sched)) {
+        return false;
+    }
+    if (table && (capacity == 0 || (capacity & (capacity - 1)) != 0)) {
+        return false;
+    }
+    for (size_t i = 0; table && i < capacity; i++) {
+        table[i] = (mu_sched_budget_t){0};
+    }
+    sched->budgets = table;
+    sched->budget_mask = table ? capacity - 1 : 0;
+    sched->run_budget = NULL;
+    return true;
+}
+
+bool mu_sched_set_budget_ex(mu_sched_t *sched, const mu_thunk_t *thunk,
+                            mu_time_rel_t budget) {
+    if (!is_scheduler_initialized(sched) || !thunk || budget <= 0) {
+        return false;
+    }
+    mu_sched_budget_t *entry = budget_entry(sched, thunk, true);
+    if (!entry) {
+        return false;
+    }
+    entry->budget = budget;
+    return true;
+}
+
+const mu_sched_budget_t *mu_sched_budget_ex(mu_sched_t *sched,
+                                            const mu_thunk_t *thunk) {
+    if (!is_scheduler_initialized(sched) || !thunk) {
+        return NULL;
+    }
+    return budget_entry(sched, thunk, false);
+}
+
+void mu_sched_set_overrun_fn_ex(mu_sched_t *sched, mu_sched_overrun_fn fn) {
+    if (!is_scheduler_initialized(sched)) {
+        return;
+    }
+    sched->overrun_fn = fn;
+}
+
+bool mu_sched_should_yield_ex(mu_sched_t *sched) {
+    if (!is_scheduler_initialized(sched) || !sched->run_budget) {
+        return false;
+    }
+    mu_time_rel_t used =
+        mu_time_difference(read_live_clock(sched), sched->run_start);
+    return used >= sched->run_budget->budget;
+}
+
+mu_time_abs_t mu_sched_current_time_ex(mu_sched_t *sched) {
+    if (!is_scheduler_initialized(sched)) {
+        // If someone calls this before init, fall back to the default
+        return mu_time_now();
+    }
+    return read_clock(sched);
+}
+
+#ifdef MU_SCHED_TRACE
+void mu_sched_set_trace_ex(mu_sched_t *sched, mu_sched_trace_t *trace) {
+    if (!is_scheduler_initialized(sched)) {
+        return;
+    }
+    sched->trace = trace;
+}
+#endif
+
+#ifdef MU_SCHED_STATS
+const mu_sched_stats_t *mu_sched_stats_ex(mu_sched_t *sched) {
+    if (!is_scheduler_initialized(sched)) {
+        return NULL;
+    }
+    return &sched->stats;
+}
+
+const mu_sched_thunk_stats_t *mu_sched_thunk_stats_ex(mu_sched_t *sched,
+                                                      const mu_thunk_t *thunk) {
+    if (!is_scheduler_initialized(sched) || !thunk) {
+        return NULL;
+    }
+    return stats_entry(sched, thunk, false);
+}
+
+void mu_sched_stats_reset_ex(mu_sched_t *sched) {
+    if (!is_scheduler_initialized(sched)) {
+        return;
+    }
+    memset(&sched->stats, 0, sizeof(sched->stats));
+}
+#endif
+
+// *****************************************************************************
+// Default instance wrappers
+
+mu_sched_t *mu_sched_default(void) { return &s_sched; }
+
+bool mu_sched_init(mu_spsc_t *interrupt_q, mu_pqueue_t *asap_q,
+                   mu_pvec_t *event_q, mu_pool_t *event_pool) {
+    return mu_sched_init_ex(&s_sched, interrupt_q, asap_q, event_q,
+                            event_pool);
+}
+
+bool mu_sched_init_wheel(mu_spsc_t *interrupt_q, mu_pqueue_t *asap_q,
+                         mu_sched_wheel_t *event_wheel, mu_pool_t *event_pool) {
+    return mu_sched_init_wheel_ex(&s_sched, interrupt_q, asap_q, event_wheel,
+                                  event_pool);
+}
+
+bool mu_sched_init_heap(mu_spsc_t *interrupt_q, mu_pqueue_t *asap_q,
+                        mu_sched_heap_t *event_heap, mu_pool_t *event_pool) {
+    return mu_sched_init_heap_ex(&s_sched, interrupt_q, asap_q, event_heap,
+                                 event_pool);
+}
+
+bool mu_sched_now(mu_thunk_t *thunk) {
+    return mu_sched_now_ex(&s_sched, thunk);
+}
+
+bool mu_sched_now_deadline(mu_thunk_t *thunk, mu_time_abs_t deadline) {
+    return mu_sched_now_deadline_ex(&s_sched, thunk, deadline);
+}
+
+bool mu_sched_now_many(mu_thunk_t *const *thunks, size_t n) {
+    return mu_sched_now_many_ex(&s_sched, thunks, n);
+}
+
+bool mu_sched_now_args(mu_thunk_t *thunk, void *args) {
+    return mu_sched_now_args_ex(&s_sched, thunk, args);
+}
+
+bool mu_sched_now_once(mu_sched_once_t *once) {
+    return mu_sched_now_once_ex(&s_sched, once);
+}
+
+bool mu_sched_at_args(mu_thunk_t *thunk, mu_time_abs_t timestamp, void *args) {
+    return mu_sched_at_args_ex(&s_sched, thunk, timestamp, args);
+}
+
+bool mu_sched_at_many(mu_thunk_t *const *thunks,
+                      const mu_time_abs_t *timestamps, size_t n) {
+    return mu_sched_at_many_ex(&s_sched, thunks, timestamps, n);
+}
+
+bool mu_sched_at(mu_thunk_t *thunk, mu_time_abs_t timestamp) {
+    return mu_sched_at_ex(&s_sched, thunk, timestamp);
+}
+
+bool mu_sched_in(mu_thunk_t *thunk, mu_time_rel_t delay) {
+    return mu_sched_in_ex(&s_sched, thunk, delay);
+}
+
+bool mu_sched_at_handle(mu_thunk_t *thunk, mu_time_abs_t timestamp,
+                        mu_sched_handle_t *handle) {
+    return mu_sched_at_handle_ex(&s_sched, thunk, timestamp, handle);
+}
+
+bool mu_sched_in_handle(mu_thunk_t *thunk, mu_time_rel_t delay,
+                        mu_sched_handle_t *handle) {
+    return mu_sched_in_handle_ex(&s_sched, thunk, delay, handle);
+}
+
+bool mu_sched_in_slack(mu_thunk_t *thunk, mu_time_rel_t delay,
+                       mu_time_rel_t slack, mu_sched_handle_t *handle) {
+    return mu_sched_in_slack_ex(&s_sched, thunk, delay, slack, handle);
+}
+
+bool mu_sched_every(mu_thunk_t *thunk, mu_time_rel_t period) {
+    return mu_sched_every_ex(&s_sched, thunk, period);
+}
+
+bool mu_sched_every_handle(mu_thunk_t *thunk, mu_time_rel_t period,
+                           mu_sched_handle_t *handle) {
+    return mu_sched_every_handle_ex(&s_sched, thunk, period, handle);
+}
+
+bool mu_sched_at_event(mu_event_t *evt, mu_thunk_t *thunk,
+                       mu_time_abs_t timestamp) {
+    return mu_sched_at_event_ex(&s_sched, evt, thunk, timestamp);
+}
+
+bool mu_sched_in_event(mu_event_t *evt, mu_thunk_t *thunk,
+                       mu_time_rel_t delay) {
+    return mu_sched_in_event_ex(&s_sched, evt, thunk, delay);
+}
+
+bool mu_sched_cancel_event(mu_event_t *evt) {
+    return mu_sched_cancel_event_ex(&s_sched, evt);
+}
+
+bool mu_sched_cancel(mu_sched_handle_t *handle) {
+    return mu_sched_cancel_ex(&s_sched, handle);
+}
+
+bool mu_sched_from_isr(mu_thunk_t *thunk) {
+    return mu_sched_from_isr_ex(&s_sched, thunk);
+}
+
+bool mu_sched_from_isr_args(mu_thunk_t *thunk, void *args) {
+    return mu_sched_from_isr_args_ex(&s_sched, thunk, args);
+}
+
+bool mu_sched_from_isr_once(mu_sched_once_t *once) {
+    return mu_sched_from_isr_once_ex(&s_sched, once);
+}
+
+bool mu_sched_now_prio(mu_thunk_t *thunk, unsigned level) {
+    return mu_sched_now_prio_ex(&s_sched, thunk, level);
+}
+
+bool mu_sched_set_prio_queue(unsigned level, mu_pqueue_t *prio_q) {
+    return mu_sched_set_prio_queue_ex(&s_sched, level, prio_q);
+}
+
+void mu_sched_set_overload_policy(mu_sched_overload_t policy) {
+    mu_sched_set_overload_policy_ex(&s_sched, policy);
+}
+
+const mu_sched_overload_stats_t *mu_sched_overload_stats(void) {
+    return mu_sched_overload_stats_ex(&s_sched);
+}
+
+void mu_sched_overload_stats_reset(void) {
+    mu_sched_overload_stats_reset_ex(&s_sched);
+}
+
+void mu_sched_set_lazy_promotion(bool enabled) {
+    mu_sched_set_lazy_promotion_ex(&s_sched, enabled);
+}
+
+void mu_sched_sim_start(mu_time_abs_t start) {
+    mu_sched_sim_start_ex(&s_sched, start);
+}
+
+void mu_sched_sim_stop(void) { mu_sched_sim_stop_ex(&s_sched); }
+
+void mu_sched_sim_advance(mu_time_rel_t dt) {
+    mu_sched_sim_advance_ex(&s_sched, dt);
+}
+
+size_t mu_sched_sim_run_until(mu_time_abs_t end) {
+    return mu_sched_sim_run_until_ex(&s_sched, end);
+}
+
+void mu_sched_set_edf_queue(mu_sched_edf_t *edf_q) {
+    mu_sched_set_edf_queue_ex(&s_sched, edf_q);
+}
+
+void mu_sched_set_remote_queue(struct mu_sched_mpsc *remote_q) {
+    mu_sched_set_remote_queue_ex(&s_sched, remote_q);
+}
+
+bool mu_sched_post_remote(mu_thunk_t *thunk) {
+    return mu_sched_post_remote_ex(&s_sched, thunk);
+}
+
+int mu_sched_delete_thunk_events(mu_thunk_t *thunk) {
+    return mu_sched_delete_thunk_events_ex(&s_sched, thunk);
+}
+
+void mu_sched_set_idle_thunk(mu_thunk_t *idle) {
+    mu_sched_set_idle_thunk_ex(&s_sched, idle);
+}
+
+void mu_sched_set_time_fn(mu_time_abs_t (*fn)(void)) {
+    mu_sched_set_time_fn_ex(&s_sched, fn);
+}
+
+void mu_sched_set_coarse_clock(bool enabled) {
+    mu_sched_set_coarse_clock_ex(&s_sched, enabled);
+}
+
+void mu_sched_step(void) { mu_sched_step_ex(&s_sched); }
+
+size_t mu_sched_step_n(size_t max_thunks) {
+    return mu_sched_step_n_ex(&s_sched, max_thunks);
+}
+
+bool mu_sched_take_ready(mu_thunk_t **thunk) {
+    return mu_sched_take_ready_ex(&s_sched, thunk);
+}
+
+bool mu_sched_take_ready_args(mu_thunk_t **thunk, void **args) {
+    return mu_sched_take_ready_args_ex(&s_sched, thunk, args);
+}
+
+void mu_sched_run(mu_thunk_t *thunk) { mu_sched_run_ex(&s_sched, thunk); }
+
+void mu_sched_run_args(mu_thunk_t *thunk, void *args) {
+    mu_sched_run_args_ex(&s_sched, thunk, args);
+}
+
+bool mu_sched_has_runnable_thunk(void) {
+    return mu_sched_has_runnable_thunk_ex(&s_sched);
+}
+
+bool mu_sched_snapshot(mu_sched_snapshot_t *snap, mu_sched_pending_t *pending,
+                       size_t max_pending) {
+    return mu_sched_snapshot_ex(&s_sched, snap, pending, max_pending);
+}
+
+bool mu_sched_next_deadline(mu_time_abs_t *out) {
+    return mu_sched_next_deadline_ex(&s_sched, out);
+}
+
+bool mu_sched_idle_timeout(mu_time_rel_t *timeout) {
+    return mu_sched_idle_timeout_ex(&s_sched, timeout);
+}
+
+const mu_thunk_t *mu_sched_current_thunk(void) {
+    return mu_sched_current_thunk_ex(&s_sched);
+}
+
+bool mu_sched_set_budget_table(mu_sched_budget_t *table, size_t capacity) {
+    return mu_sched_set_budget_table_ex(&s_sched, table, capacity);
+}
+
+bool mu_sched_set_budget(const mu_thunk_t *thunk, mu_time_rel_t budget) {
+    return mu_sched_set_budget_ex(&s_sched, thunk, budget);
+}
+
+const mu_sched_budget_t *mu_sched_budget(const mu_thunk_t *thunk) {
+    return mu_sched_budget_ex(&s_sched, thunk);
+}
+
+void mu_sched_set_overrun_fn(mu_sched_overrun_fn fn) {
+    mu_sched_set_overrun_fn_ex(&s_sched, fn);
+}
+
+bool mu_sched_should_yield(void) { return mu_sched_should_yield_ex(&s_sched); }
+
+mu_time_abs_t mu_sched_current_time(void) {
+    return mu_sched_current_time_ex(&s_sched);
+}
+
+#ifdef MU_SCHED_TRACE
+void mu_sched_set_trace(mu_sched_trace_t *trace) {
+    mu_sched_set_trace_ex(&s_sched, trace);
+}
+#endif
+
+#ifdef MU_SCHED_STATS
+const mu_sched_stats_t *mu_sched_stats(void) {
+    return mu_sched_stats_ex(&s_sched);
+}
+
+const mu_sched_thunk_stats_t *mu_sched_thunk_stats(const mu_thunk_t *thunk) {
+    return mu_sched_thunk_stats_ex(&s_sched, thunk);
+}
+
+void mu_sched_stats_reset(void) { mu_sched_stats_reset_ex(&s_sched); }
+#endif
+
+// *****************************************************************************
+// Private function implementations
+
+static bool is_scheduler_initialized(mu_sched_t *sched) {
+    return sched != NULL && sched->initialized;
+}
+
+static void init_common(mu_sched_t *sched, mu_spsc_t *interrupt_q,
+                        mu_pqueue_t *asap_q, mu_pool_t *event_pool) {
+    sched->interrupt_q = interrupt_q;
+    sched->asap_q = asap_q;
+    sched->edf_q = NULL;
+    for (unsigned level = 0; level < MU_SCHED_PRIO_LEVELS; level++) {
+        sched->prio_q[level] = NULL;
+    }
+    sched->prio_ready = 0;
+    sched->overload_policy = MU_SCHED_OVERLOAD_DEFER;
+    sched->overload = (mu_sched_overload_stats_t){0};
+    sched->lazy_promotion = false;
+    sched->event_pool = event_pool;
+    sched->idle_thunk = NULL;
+    sched->current_thunk = NULL;
+    sched->remote_q = NULL;
+    sched->budgets = NULL;
+    sched->budget_mask = 0;
+    sched->run_budget = NULL;
+    sched->overrun_fn = NULL;
+    sched->isr_posts = 0;
+    sched->isr_takes = 0;
+    sched->pool_in_use = 0;
+    sched->get_time = mu_time_now; // Default time source
+    sched->simulated = false;
+    sched->clock_cached = false;
+    sched->coarse_clock = false;
+    sched->event_seq = 0;
+#ifdef MU_SCHED_STATS
+    memset(&sched->stats, 0, sizeof(sched->stats));
+#endif
+#ifdef MU_SCHED_TRACE
+    sched->trace = NULL;
+#endif
+}
+
+static size_t promote_due_events(mu_sched_t *sched, mu_time_abs_t now) {
+    mu_event_t *evt;
+    mu_event_time_t now_t = mu_event_time_of(now);
+    size_t promoted = 0;
+
+    event_store_advance(sched, now);
+    if (sched->lazy_promotion) {
+        return 0; // due events are run in place by run_ready_thunk()
+    }
+    while ((evt = event_store_peek(sched)) != NULL &&
+           !mu_event_time_is_before(now_t, evt->timestamp)) {
+
+        if (evt->flags & EVENT_CANCELLED) {
+            /* Tombstone left by mu_sched_cancel(): discard it */
+            event_store_pop(sched);
+            free_event(sched, evt);
+            continue;
+        }
+        if (sched->overload_policy == MU_SCHED_OVERLOAD_DEFER &&
+            ready_is_full(sched)) {
+            /* Leave due events in the store until there is room */
+            sched->overload.deferred++;
+            break;
+        }
+        event_store_pop(sched);
+
+        // An EDF queue ranks the thunk by when it was due, however late
+        mu_time_abs_t due = event_abs_time(evt->timestamp, now);
+        // With an argument (one-shot only), the wrapper itself moves over
+        bool message = evt->args != NULL;
+        if (message) {
+            evt->flags = 0; // no longer pending: handles can't cancel it
+        }
+        if (ready_admit(sched, message ? message_item(evt) : evt->thunk,
+                        due)) {
+            TRACE(sched, MU_SCHED_TRACE_PROMOTE, evt->thunk);
+#ifdef MU_SCHED_STATS
+            stats_note_due(sched, evt->thunk, due);
+#endif
+            promoted++;
+            if (message) {
+                continue;
+            }
+        } else {
+            /* Ready queue full: drop this occurrence */
+            sched->overload.dropped_due++;
+        }
+
+        if (evt->period > 0) {
+            /* Periodic: re-arm the same wrapper.  It was just popped, so
+             * there is room for it, and its new deadline is after `now`. */
+            next_period(evt, now);
+            event_store_insert(sched, evt);
+            continue;
+        }
+
+        /* Free the event wrapper now that its thunk is enqueued or dropped */
+        free_event(sched, evt);
+    }
+    return promoted;
+}
+
+static bool take_due_event(mu_sched_t *sched, mu_time_abs_t now,
+                           mu_thunk_t **thunk, void **args) {
+    mu_event_t *evt;
+    mu_event_time_t now_t = mu_event_time_of(now);
+
+    if (!sched->lazy_promotion) {
+        return false;
+    }
+    while ((evt = event_store_peek(sched)) != NULL &&
+           !mu_event_time_is_before(now_t, evt->timestamp)) {
+        event_store_pop(sched);
+        if (evt->flags & EVENT_CANCELLED) {
+            free_event(sched, evt);
+            continue;
+        }
+        *thunk = evt->thunk;
+        *args = evt->args;
+        TRACE(sched, MU_SCHED_TRACE_PROMOTE, evt->thunk);
+#ifdef MU_SCHED_STATS
+        stats_note_due(sched, evt->thunk, event_abs_time(evt->timestamp, now));
+#endif
+        // Settle the wrapper first: the thunk may reschedule or cancel
+        if (evt->period > 0) {
+            next_period(evt, now);
+            event_store_insert(sched, evt);
+        } else {
+            free_event(sched, evt);
+        }
+        return true;
+    }
+    return false;
+}
+
+static bool due_event_first(mu_sched_t *sched, mu_time_abs_t now) {
+    mu_event_time_t deadline;
+
+    if (!sched->lazy_promotion || sched->prio_ready || !sched->edf_q ||
+        !mu_sched_edf_peek_deadline(sched->edf_q, &deadline)) {
+        return false;
+    }
+    // Ties go to the ready thunk, which was queued first
+    mu_event_t *evt = event_store_peek(sched);
+    return evt != NULL &&
+           !mu_event_time_is_before(mu_event_time_of(now), evt->timestamp) &&
+           mu_event_time_is_before(evt->timestamp, deadline);
+}
+
+static bool ready_put(mu_sched_t *sched, mu_thunk_t *thunk,
+                      mu_time_abs_t deadline) {
+    bool ok = sched->edf_q
+                  ? mu_sched_edf_put(sched->edf_q, thunk, deadline)
+                  : mu_pqueue_put(sched->asap_q, thunk) == MU_STORE_ERR_NONE;
+    if (ok) {
+        size_t count = ready_count(sched);
+        if (count > sched->overload.ready_hwm) {
+            sched->overload.ready_hwm = count;
+        }
+    }
+    return ok;
+}
+
+static bool ready_admit(mu_sched_t *sched, mu_thunk_t *thunk,
+                        mu_time_abs_t deadline) {
+    void *oldest;
+    // The EDF queue has no notion of oldest, so it never evicts
+    if (sched->overload_policy == MU_SCHED_OVERLOAD_DROP_OLDEST &&
+        !sched->edf_q && mu_pqueue_is_full(sched->asap_q) &&
+        mu_pqueue_get(sched->asap_q, &oldest) == MU_STORE_ERR_NONE) {
+        mu_thunk_t *dropped;
+        void *args;
+        open_item(sched, oldest, &dropped, &args);
+        sched->overload.dropped_ready++;
+    }
+    return ready_put(sched, thunk, deadline);
+}
+
+static bool ready_get(mu_sched_t *sched, mu_thunk_t **thunk, void **args) {
+    mu_thunk_t *item;
+    // Thunks queued before an EDF queue was attached still drain
+    if ((sched->prio_ready && prio_get(sched, &item)) ||
+        (sched->edf_q && mu_sched_edf_get(sched->edf_q, &item)) ||
+        mu_pqueue_get(sched->asap_q, (void **)&item) == MU_STORE_ERR_NONE) {
+        open_item(sched, item, thunk, args);
+        return true;
+    }
+    return false;
+}
+
+static mu_thunk_t *message_item(mu_event_t *evt) {
+    return (mu_thunk_t *)((uintptr_t)evt | 1u);
+}
+
+static bool is_message(const mu_thunk_t *item) {
+    return ((uintptr_t)item & 1u) != 0;
+}
+
+static void open_item(mu_sched_t *sched, mu_thunk_t *item, mu_thunk_t **thunk,
+                      void **args) {
+    if (is_once(item)) {
+        mu_sched_once_t *once =
+            (mu_sched_once_t *)((uintptr_t)item & ~(uintptr_t)2u);
+        *thunk = once->thunk;
+        *args = NULL;
+        ONCE_CLEAR(&once->queued);
+        return;
+    }
+    if (!is_message(item)) {
+        *thunk = item;
+        *args = NULL;
+        return;
+    }
+    mu_event_t *evt = (mu_event_t *)((uintptr_t)item & ~(uintptr_t)1u);
+    *thunk = evt->thunk;
+    *args = evt->args;
+    release_event(sched, evt);
+}
+
+static mu_thunk_t *once_item(mu_sched_once_t *once) {
+    return (mu_thunk_t *)((uintptr_t)once | 2u);
+}
+
+static bool is_once(const mu_thunk_t *item) {
+    return ((uintptr_t)item & 2u) != 0;
+}
+
+static bool ready_is_full(const mu_sched_t *sched) {
+    if (sched->edf_q) {
+        return mu_sched_edf_is_full(sched->edf_q);
+    }
+    return mu_pqueue_is_full(sched->asap_q);
+}
+
+static size_t ready_count(const mu_sched_t *sched) {
+    if (sched->edf_q) {
+        return mu_sched_edf_count(sched->edf_q);
+    }
+    return mu_pqueue_count(sched->asap_q);
+}
+
+static size_t ready_room(const mu_sched_t *sched) {
+    if (sched->edf_q) {
+        return mu_sched_edf_capacity(sched->edf_q) -
+               mu_sched_edf_count(sched->edf_q);
+    }
+    return mu_pqueue_capacity(sched->asap_q) -
+           mu_pqueue_count(sched->asap_q);
+}
+
+static bool ready_is_empty(const mu_sched_t *sched) {
+    if (sched->prio_ready) {
+        return false;
+    }
+    if (sched->edf_q && !mu_sched_edf_is_empty(sched->edf_q)) {
+        return false;
+    }
+    return mu_pqueue_is_empty(sched->asap_q);
+}
+
+static bool prio_get(mu_sched_t *sched, mu_thunk_t **thunk) {
+    while (sched->prio_ready) {
+        unsigned level = msb32(sched->prio_ready);
+        mu_pqueue_t *q = sched->prio_q[level];
+        if (mu_pqueue_get(q, (void **)thunk) == MU_STORE_ERR_NONE) {
+            if (mu_pqueue_is_empty(q)) {
+                sched->prio_ready &= ~(1u << level);
+            }
+            return true;
+        }
+        sched->prio_ready &= ~(1u << level);
+    }
+    return false;
+}
+
+static unsigned msb32(uint32_t x) {
+#if defined(__GNUC__)
+    return 31u - (unsigned)__builtin_clz(x);
+#else
+    unsigned n = 0;
+    while (x >>= 1) {
+        n++;
+    }
+    return n;
+#endif
+}
+
+static size_t drain_remote_queue(mu_sched_t *sched, mu_time_abs_t now) {
+    void *item;
+    void *args;
+    size_t moved = 0;
+
+    if (!sched->remote_q) {
+        return 0;
+    }
+    while (!ready_is_full(sched) &&
+           mu_sched_mpsc_peek_args(sched->remote_q, &item, &args) ==
+               MU_SCHED_MPSC_ERR_NONE) {
+        mu_event_t *evt = NULL;
+        // Only an item with an argument needs a wrapper.  If the pool is dry
+        // it stays at the head of the queue, keeping the queue in order.
+        if (args && sched->event_pool && (evt = alloc_event(sched)) == NULL) {
+            break;
+        }
+        mu_sched_mpsc_get_args(sched->remote_q, &item, &args);
+        if (evt) {
+            evt->thunk = item;
+            evt->args = args;
+            evt->flags = 0;
+            item = message_item(evt);
+        }
+        ready_put(sched, item, now);
+        moved++;
+    }
+    return moved;
+}
+
+static bool schedule_event(mu_sched_t *sched, mu_thunk_t *thunk,
+                           mu_time_abs_t timestamp, mu_time_rel_t period,
+                           void *args, mu_sched_handle_t *handle) {
+    if (!sched->event_pool) {
+        return false; // intrusive-only scheduler
+    }
+    mu_event_t *evt = alloc_event(sched);
+    if (!evt) {
+        return false;
+    }
+    if (!insert_event(sched, evt, thunk, timestamp, period, EVENT_PENDING)) {
+        release_event(sched, evt);
+        return false;
+    }
+    evt->args = args;
+    if (handle) {
+        handle->event = evt;
+        handle->seq = evt->seq;
+    }
+    TRACE(sched, MU_SCHED_TRACE_AT, thunk);
+    return true;
+}
+
+static bool insert_event(mu_sched_t *sched, mu_event_t *evt,
+                         mu_thunk_t *thunk, mu_time_abs_t timestamp,
+                         mu_time_rel_t period, uint8_t flags) {
+    evt->thunk = thunk;
+    evt->timestamp = mu_event_time_of(timestamp);
+    evt->period = period;
+    evt->args = NULL;
+    evt->seq = sched->event_seq++;
+    evt->flags = flags;
+    if (!event_store_insert(sched, evt)) {
+        evt->flags = 0;
+        return false;
+    }
+    note_event_count(sched);
+    return true;
+}
+
+static void note_event_count(mu_sched_t *sched) {
+    size_t count = event_store_count(sched);
+    if (count > sched->overload.event_hwm) {
+        sched->overload.event_hwm = count;
+    }
+}
+
+static void unlink_event(mu_sched_t *sched, mu_event_t *evt) {
+    if (!sched->event_q) {
+        // Only the pvec has tombstones: elsewhere cancelled events are gone
+        if (!(evt->flags & EVENT_CANCELLED)) {
+            event_store_remove(sched, evt);
+        }
+        return;
+    }
+    for (size_t i = mu_pvec_count(sched->event_q); i-- > 0;) {
+        mu_event_t *item;
+        if (mu_pvec_ref(sched->event_q, i, (void **)&item) ==
+                MU_STORE_ERR_NONE &&
+            item == evt) {
+            mu_pvec_delete(sched->event_q, i, (void **)&item);
+            return;
+        }
+    }
+}
+
+static void next_period(mu_event_t *evt, mu_time_abs_t now) {
+    mu_event_time_t now_t = mu_event_time_of(now);
+    mu_time_rel_t step = evt->period;
+    mu_event_time_t next = mu_event_time_offset(evt->timestamp, step);
+
+    if (!mu_event_time_is_before(now_t, next)) {
+        /* Fell more than a period behind: skip the missed deadlines */
+        mu_time_rel_t behind = mu_event_time_difference(now_t, evt->timestamp);
+        step = (behind / evt->period + 1) * evt->period;
+        next = mu_event_time_offset(evt->timestamp, step);
+    }
+    evt->timestamp = next;
+}
+
+static mu_time_abs_t coalesce_time(mu_sched_t *sched, mu_time_abs_t earliest,
+                                   mu_time_rel_t slack) {
+    if (slack == 0) {
+        return earliest;
+    }
+
+    // Join the soonest pending event if it falls in the window
+    mu_event_t *next = event_store_earliest(sched);
+    if (next) {
+        mu_time_abs_t t = event_abs_time(next->timestamp, earliest);
+        mu_time_rel_t late = mu_time_difference(t, earliest);
+        if (late >= 0 && late <= slack) {
+            return t;
+        }
+    }
+
+    // Else round up to a multiple of the largest power of two <= slack
+    uint64_t grain = 1;
+    while (grain <= (uint64_t)slack / 2) {
+        grain <<= 1;
+    }
+    uint64_t ns = (uint64_t)earliest.seconds * 1000000000u +
+                  (uint64_t)earliest.nanoseconds;
+    uint64_t rem = ns & (grain - 1);
+    return rem ? mu_time_offset(earliest, (mu_time_rel_t)(grain - rem))
+               : earliest;
+}
+
+static mu_time_abs_t read_clock(mu_sched_t *sched) {
+    if (sched->simulated) {
+        return sched->sim_time;
+    }
+    if (sched->clock_cached) {
+        return sched->clock_cache;
+    }
+    mu_time_abs_t now = sched->get_time();
+    if (sched->coarse_clock) {
+        sched->clock_cache = now;
+        sched->clock_cached = true;
+    }
+    return now;
+}
+
+static mu_time_abs_t read_live_clock(mu_sched_t *sched) {
+    return sched->simulated ? sched->sim_time : sched->get_time();
+}
+
+static mu_time_abs_t hold_clock(mu_sched_t *sched) {
+    sched->clock_cached = false;
+    sched->clock_cache = read_clock(sched);
+    sched->clock_cached = true;
+    return sched->clock_cache;
+}
+
+static void release_clock(mu_sched_t *sched) {
+    if (!sched->coarse_clock) {
+        sched->clock_cached = false;
+    }
+}
+
+static bool sim_jump(mu_sched_t *sched, mu_time_abs_t *now,
+                     const mu_time_abs_t *limit) {
+    if (!sched->simulated || !ready_is_empty(sched)) {
+        return false;
+    }
+    mu_event_t *evt = event_store_earliest(sched);
+    if (!evt) {
+        return false;
+    }
+    mu_time_abs_t deadline = event_abs_time(evt->timestamp, *now);
+    if (!mu_time_is_after(deadline, *now) ||
+        (limit && mu_time_is_after(deadline, *limit))) {
+        return false;
+    }
+    sched->sim_time = deadline;
+    *now = deadline;
+    return true;
+}
+
+static mu_time_abs_t event_abs_time(mu_event_time_t t, mu_time_abs_t now) {
+#ifdef MU_SCHED_TICK_EVENTS
+    return mu_time_offset(now,
+                          mu_event_time_difference(t, mu_event_time_of(now)));
+#else
+    (void)now;
+    return t;
+#endif
+}
+
+static bool run_interrupt_thunk(mu_sched_t *sched) {
+    mu_thunk_t *isr_item;
+    mu_thunk_t *thunk;
+    void *args;
+    if (!take_isr_item(sched, &isr_item)) {
+        return false;
+    }
+    open_item(sched, isr_item, &thunk, &args);
+    run_thunk(sched, thunk, args);
+    return true;
+}
+
+static bool run_ready_thunk(mu_sched_t *sched, mu_time_abs_t now) {
+    mu_thunk_t *thunk;
+    void *args;
+    if (!(due_event_first(sched, now) &&
+          take_due_event(sched, now, &thunk, &args)) &&
+        !ready_get(sched, &thunk, &args) &&
+        !take_due_event(sched, now, &thunk, &args)) {
+        return false;
+    }
+    run_thunk(sched, thunk, args);
+    return true;
+}
+
+static bool run_idle_thunk(mu_sched_t *sched) {
+    if (!sched->idle_thunk) {
+        return false;
+    }
+    run_thunk(sched, sched->idle_thunk, NULL);
+    return true;
+}
+
+static void run_thunk(mu_sched_t *sched, mu_thunk_t *thunk, void *args) {
+    bool held = sched->clock_cached;
+#ifdef MU_SCHED_STATS
+    mu_time_abs_t start = read_clock(sched);
+#endif
+    release_clock(sched); // the thunk sees the live clock unless coarse
+    // Only budgeted thunks pay for the extra clock reads
+    mu_sched_budget_t *budget = budget_entry(sched, thunk, false);
+    if (budget) {
+        sched->run_start = read_live_clock(sched);
+    }
+    sched->run_budget = budget;
+    sched->current_thunk = thunk;
+    TRACE(sched, MU_SCHED_TRACE_RUN_START, thunk);
+    mu_thunk_call(thunk, args);
+    TRACE(sched, MU_SCHED_TRACE_RUN_END, thunk);
+    sched->current_thunk = NULL;
+    sched->run_budget = NULL;
+    if (budget) {
+        mu_time_rel_t runtime =
+            mu_time_difference(read_live_clock(sched), sched->run_start);
+        if (runtime > budget->max_runtime) {
+            budget->max_runtime = runtime;
+        }
+        if (runtime > budget->budget) {
+            budget->overruns++;
+            if (sched->overrun_fn) {
+                sched->overrun_fn(thunk, runtime, budget->budget);
+            }
+        }
+    }
+#ifdef MU_SCHED_STATS
+    // Holding the end reading lets it double as the next thunk's start
+    mu_time_abs_t end = held ? hold_clock(sched) : read_clock(sched);
+    stats_record_run(sched, thunk, start, end);
+#else
+    sched->clock_cached = held || sched->clock_cached;
+#endif
+}
+
+static mu_sched_budget_t *budget_entry(mu_sched_t *sched,
+                                       const mu_thunk_t *thunk, bool create) {
+    if (!sched->budgets) {
+        return NULL;
+    }
+    const size_t mask = sched->budget_mask;
+    // Same hashing as stats_entry()
+    size_t i = (size_t)(((uintptr_t)thunk >> 2) * 2654435761u) & mask;
+
+    for (size_t probes = 0; probes <= mask; probes++, i = (i + 1) & mask) {
+        mu_sched_budget_t *entry = &sched->budgets[i];
+        if (entry->thunk == thunk) {
+            return entry;
+        }
+        if (entry->thunk == NULL) {
+            if (!create) {
+                return NULL;
+            }
+            entry->thunk = thunk;
+            return entry;
+        }
+    }
+    return NULL; // table full
+}
+
+#ifdef MU_SCHED_STATS
+static mu_sched_thunk_stats_t *stats_entry(mu_sched_t *sched,
+                                           const mu_thunk_t *thunk,
+                                           bool create) {
+    const size_t mask = MU_SCHED_STATS_THUNKS - 1;
+    // Fibonacci hash of the pointer, then linear probing
+    size_t i = (size_t)(((uintptr_t)thunk >> 2) * 2654435761u) & mask;
+
+    for (size_t probes = 0; probes <= mask; probes++, i = (i + 1) & mask) {
+        mu_sched_thunk_stats_t *entry = &sched->stats.thunks[i];
+        if (entry->thunk == thunk) {
+            return entry;
+        }
+        if (entry->thunk == NULL) {
+            if (!create) {
+                return NULL;
+            }
+            entry->thunk = thunk;
+            return entry;
+        }
+    }
+    return NULL; // table full
+}
+
+static void stats_note_due(mu_sched_t *sched, mu_thunk_t *thunk,
+                           mu_time_abs_t due) {
+    mu_sched_thunk_stats_t *entry = stats_entry(sched, thunk, true);
+    if (entry && !entry->due_pending) {
+        entry->due = due;
+        entry->due_pending = true;
+    }
+}
+
+static void stats_record_run(mu_sched_t *sched, mu_thunk_t *thunk,
+                             mu_time_abs_t start, mu_time_abs_t end) {
+    mu_sched_thunk_stats_t *entry = stats_entry(sched, thunk, true);
+    if (!entry) {
+        sched->stats.untracked_calls++;
+        return;
+    }
+
+    mu_time_rel_t runtime = mu_time_difference(end, start);
+    entry->calls++;
+    entry->total_runtime += runtime;
+    if (runtime > entry->max_runtime) {
+        entry->max_runtime = runtime;
+    }
+
+    if (entry->due_pending) {
+        mu_time_rel_t lag = mu_time_is_after(start, entry->due)
+                                ? mu_time_difference(start, entry->due)
+                                : 0;
+        entry->due_pending = false;
+        entry->timed_calls++;
+        entry->total_lateness += lag;
+        if (lag > entry->max_lateness) {
+            entry->max_lateness = lag;
+        }
+        sched->stats.lag_histogram[stats_lag_bucket(lag)]++;
+    }
+}
+
+static size_t stats_lag_bucket(mu_time_rel_t lag) {
+    size_t bucket = 0;
+    while (lag > 0 && bucket < MU_SCHED_STATS_LAG_BUCKETS - 1) {
+        lag >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+#endif
+
+static void free_event(mu_sched_t *sched, mu_event_t *evt) {
+    bool intrusive = (evt->flags & EVENT_INTRUSIVE) != 0;
+    evt->flags = 0;
+    if (!intrusive) {
+        release_event(sched, evt);
+    }
+}
+
+static mu_event_t *alloc_event(mu_sched_t *sched) {
+    mu_event_t *evt = mu_pool_alloc(sched->event_pool);
+    if (evt && ++sched->pool_in_use > sched->overload.pool_hwm) {
+        sched->overload.pool_hwm = sched->pool_in_use;
+    }
+    return evt;
+}
+
+static void release_event(mu_sched_t *sched, mu_event_t *evt) {
+    mu_pool_free(sched->event_pool, evt);
+    sched->pool_in_use--;
+}
+
+static bool take_isr_item(mu_sched_t *sched, mu_thunk_t **item) {
+    mu_spsc_item_t isr_item;
+    if (mu_spsc_get(sched->interrupt_q, &isr_item) != MU_SPSC_ERR_NONE) {
+        return false;
+    }
+    // The ISR counts a post before publishing it, so this includes the item
+    // just taken.  A post that is about to fail may add one for a moment.
+    size_t depth = (uint32_t)(sched->isr_posts - sched->isr_takes);
+    sched->isr_takes++;
+    if (depth > sched->overload.isr_hwm) {
+        sched->overload.isr_hwm = depth;
+    }
+    *item = (mu_thunk_t *)isr_item;
+    return true;
+}
+
+static void collect_pending(const mu_event_t *evt, void *ctx) {
+    snapshot_collector_t *collector = ctx;
+    if (evt->flags & EVENT_CANCELLED) {
+        return;
+    }
+    mu_time_abs_t due = event_abs_time(evt->timestamp, collector->now);
+    size_t i = collector->count;
+    if (i == collector->max_pending) {
+        if (!mu_time_is_before(due, collector->pending[i - 1].timestamp)) {
+            return; // not among the soonest
+        }
+        i--;
+    } else {
+        collector->count++;
+    }
+    // Insertion sort; equal times keep the order they were visited in
+    mu_sched_pending_t *pending = collector->pending;
+    while (i > 0 && mu_time_is_before(due, pending[i - 1].timestamp)) {
+        pending[i] = pending[i - 1];
+        i--;
+    }
+    pending[i] = (mu_sched_pending_t){evt->thunk, due, evt->period};
+}
+
+static void event_store_visit(mu_sched_t *sched, mu_event_visit_fn fn,
+                              void *ctx) {
+    if (sched->event_wheel) {
+        mu_sched_wheel_visit(sched->event_wheel, fn, ctx);
+        return;
+    }
+    if (sched->event_heap) {
+        mu_sched_heap_visit(sched->event_heap, fn, ctx);
+        return;
+    }
+    // Soonest is last: visiting backwards keeps equal times in FIFO order
+    for (size_t i = mu_pvec_count(sched->event_q); i-- > 0;) {
+        void *evt;
+        mu_pvec_ref(sched->event_q, i, &evt);
+        fn(evt, ctx);
+    }
+}
+
+static bool event_store_insert(mu_sched_t *sched, mu_event_t *evt) {
+    if (sched->event_wheel) {
+        mu_sched_wheel_insert(sched->event_wheel, evt);
+        return true;
+    }
+    if (sched->event_heap) {
+        return mu_sched_heap_insert(sched->event_heap, evt);
+    }
+    return mu_pvec_sorted_insert(sched->event_q, evt, compare_events,
+                                 MU_STORE_INSERT_FIRST) == MU_STORE_ERR_NONE;
+}
+
+static void event_store_advance(mu_sched_t *sched, mu_time_abs_t now) {
+    if (sched->event_wheel) {
+        mu_sched_wheel_advance(sched->event_wheel, now);
+    }
+}
+
+static mu_event_t *event_store_peek(mu_sched_t *sched) {
+    mu_event_t *evt;
+    if (sched->event_wheel) {
+        return mu_sched_wheel_peek(sched->event_wheel);
+    }
+    if (sched->event_heap) {
+        return mu_sched_heap_peek(sched->event_heap);
+    }
+    if (mu_pvec_peek(sched->event_q, (void **)&evt) != MU_STORE_ERR_NONE) {
+        return NULL;
+    }
+    return evt;
+}
+
+static mu_event_t *event_store_earliest(mu_sched_t *sched) {
+    mu_event_t *evt;
+    if (sched->event_wheel) {
+        return mu_sched_wheel_earliest(sched->event_wheel);
+    }
+    if (sched->event_heap) {
+        return mu_sched_heap_peek(sched->event_heap);
+    }
+    // The pvec is sorted soonest-last; skip any tombstones at the end.
+    for (size_t i = mu_pvec_count(sched->event_q); i-- > 0;) {
+        if (mu_pvec_ref(sched->event_q, i, (void **)&evt) ==
+                MU_STORE_ERR_NONE &&
+            !(evt->flags & EVENT_CANCELLED)) {
+            return evt;
+        }
+    }
+    return NULL;
+}
+
+static size_t event_store_count(const mu_sched_t *sched) {
+    if (sched->event_wheel) {
+        return mu_sched_wheel_count(sched->event_wheel);
+    }
+    if (sched->event_heap) {
+        return mu_sched_heap_count(sched->event_heap);
+    }
+    return mu_pvec_count(sched->event_q); // including tombstones
+}
+
+static void event_store_pop(mu_sched_t *sched) {
+    mu_event_t *evt;
+    if (sched->event_wheel) {
+        mu_sched_wheel_pop(sched->event_wheel);
+    } else if (sched->event_heap) {
+        mu_sched_heap_pop(sched->event_heap);
+    } else {
+        mu_pvec_pop(sched->event_q, (void **)&evt);
+    }
+}
+
+static bool event_store_remove(mu_sched_t *sched, mu_event_t *evt) {
+    if (sched->event_wheel) {
+        mu_sched_wheel_remove(sched->event_wheel, evt);
+        return true;
+    }
+    if (sched->event_heap) {
+        mu_sched_heap_remove(sched->event_heap, evt);
+        return true;
+    }
+    return false;
+}
+
+static size_t event_store_room(const mu_sched_t *sched) {
+    if (sched->event_wheel) {
+        return SIZE_MAX; // the wheel links events, it never fills
+    }
+    if (sched->event_heap) {
+        return mu_sched_heap_capacity(sched->event_heap) -
+               mu_sched_heap_count(sched->event_heap);
+    }
+    return mu_pvec_capacity(sched->event_q) - mu_pvec_count(sched->event_q);
+}
+
+static mu_event_t *sort_events(mu_event_t *list) {
+    if (!list || !list->next) {
+        return list;
+    }
+
+    // Split in half, sort each half, then merge them
+    mu_event_t *slow = list;
+    for (mu_event_t *fast = list->next; fast && fast->next;
+         fast = fast->next->next) {
+        slow = slow->next;
+    }
+    mu_event_t *back = sort_events(slow->next);
+    slow->next = NULL;
+    list = sort_events(list);
+
+    mu_event_t *sorted = NULL;
+    mu_event_t **link = &sorted;
+    while (list && back) {
+        mu_event_t **src = mu_event_is_before(back, list) ? &back : &list;
+        mu_event_t *evt = *src;
+        *src = evt->next;
+        *link = evt;
+        link = &evt->next;
+    }
+    *link = list ? list : back;
+    return sorted;
+}
+
+static bool event_store_merge(mu_sched_t *sched, mu_event_t *sorted) {
+    mu_event_t *evt;
+    bool ok = true;
+
+    if (!sched->event_q) {
+        while ((evt = sorted) != NULL) {
+            sorted = evt->next;
+            ok = event_store_insert(sched, evt) && ok;
+        }
+        return ok;
+    }
+    if (!sorted) {
+        return true;
+    }
+
+    // The pvec is sorted soonest-last.  Pop every event that runs before the
+    // batch's latest one, merge those with the batch as lists, then push the
+    // result back latest first.  Each event leaves and re-enters the vector
+    // once and nothing is shifted, so this is O(n + k), not O(n * k).
+    mu_event_t *latest = sorted;
+    while (latest->next) {
+        latest = latest->next;
+    }
+    mu_event_t *popped = NULL; // soonest first, in run order
+    mu_event_t **link = &popped;
+    void *item;
+    while (mu_pvec_peek(sched->event_q, &item) == MU_STORE_ERR_NONE &&
+           !mu_event_time_is_before(latest->timestamp,
+                                    ((mu_event_t *)item)->timestamp)) {
+        mu_pvec_pop(sched->event_q, &item);
+        evt = item;
+        evt->next = NULL;
+        *link = evt;
+        link = &evt->next;
+    }
+
+    mu_event_t *merged = NULL; // latest first
+    while (popped || sorted) {
+        // On equal timestamps the events already scheduled run first
+        bool take_popped =
+            popped && (!sorted || !mu_event_time_is_before(sorted->timestamp,
+                                                           popped->timestamp));
+        if (take_popped) {
+            evt = popped;
+            popped = evt->next;
+        } else {
+            evt = sorted;
+            sorted = evt->next;
+        }
+        evt->next = merged;
+        merged = evt;
+    }
+    while ((evt = merged) != NULL) {
+        merged = evt->next;
+        ok = mu_pvec_push(sched->event_q, evt) == MU_STORE_ERR_NONE && ok;
+    }
+    return ok;
+}
 
 static int compare_events(const void *a, const void *b) {
     const mu_event_t *ea = *(const mu_event_t *const *)a;
     const mu_event_t *eb = *(const mu_event_t *const *)b;
     // Ascending timestamp: earliest events get put at the end of the event_q
-    if (mu_time_is_before(ea->timestamp, eb->timestamp)) {
+    if (mu_event_time_is_before(ea->timestamp, eb->timestamp)) {
         return 1;
-    } else if (mu_time_is_after(ea->timestamp, eb->timestamp)) {
+    } else if (mu_event_time_is_before(eb->timestamp, ea->timestamp)) {
         return -1;
     }
     return 0;
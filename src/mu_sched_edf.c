@@ -0,0 +1,158 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_edf.c
+ * @brief Earliest-deadline-first ready queue for mu_sched.
+ *
+ * A binary min-heap of entries stored by value: the children of node i are
+ * nodes 2i+1 and 2i+2.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_sched_edf.h"
+#include "mu_event.h"
+#include "mu_thunk.h"
+#include "mu_time.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private function prototypes
+
+/**
+ * @brief Returns true if entry a is more urgent than entry b.
+ */
+static bool is_before(const mu_sched_edf_entry_t *a,
+                      const mu_sched_edf_entry_t *b);
+
+// *****************************************************************************
+// Public function implementations
+
+mu_sched_edf_t *mu_sched_edf_init(mu_sched_edf_t *edf,
+                                  mu_sched_edf_entry_t *store,
+                                  size_t capacity) {
+    if (!edf || !store || capacity == 0) {
+        return NULL;
+    }
+    edf->items = store;
+    edf->capacity = capacity;
+    edf->count = 0;
+    edf->seq = 0;
+    return edf;
+}
+
+size_t mu_sched_edf_count(const mu_sched_edf_t *edf) {
+    return edf->count;
+}
+
+size_t mu_sched_edf_capacity(const mu_sched_edf_t *edf) {
+    return edf->capacity;
+}
+
+bool mu_sched_edf_is_empty(const mu_sched_edf_t *edf) {
+    return edf->count == 0;
+}
+
+bool mu_sched_edf_is_full(const mu_sched_edf_t *edf) {
+    return edf->count == edf->capacity;
+}
+
+bool mu_sched_edf_put(mu_sched_edf_t *edf, mu_thunk_t *thunk,
+                      mu_time_abs_t deadline) {
+    if (mu_sched_edf_is_full(edf)) {
+        return false;
+    }
+    mu_sched_edf_entry_t entry = {
+        .thunk = thunk,
+        .deadline = mu_event_time_of(deadline),
+        .seq = edf->seq++,
+    };
+
+    // Sift up: move parents down until entry's slot is found
+    size_t i = edf->count++;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!is_before(&entry, &edf->items[parent])) {
+            break;
+        }
+        edf->items[i] = edf->items[parent];
+        i = parent;
+    }
+    edf->items[i] = entry;
+    return true;
+}
+
+bool mu_sched_edf_get(mu_sched_edf_t *edf, mu_thunk_t **thunk) {
+    if (mu_sched_edf_is_empty(edf)) {
+        return false;
+    }
+    *thunk = edf->items[0].thunk;
+
+    // Sift the last entry down from the root
+    mu_sched_edf_entry_t last = edf->items[--edf->count];
+    size_t n = edf->count;
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= n) {
+            break;
+        }
+        if (child + 1 < n &&
+            is_before(&edf->items[child + 1], &edf->items[child])) {
+            child++;
+        }
+        if (!is_before(&edf->items[child], &last)) {
+            break;
+        }
+        edf->items[i] = edf->items[child];
+        i = child;
+    }
+    if (n > 0) {
+        edf->items[i] = last;
+    }
+    return true;
+}
+
+bool mu_sched_edf_peek_deadline(const mu_sched_edf_t *edf,
+                                mu_event_time_t *deadline) {
+    if (mu_sched_edf_is_empty(edf)) {
+        return false;
+    }
+    *deadline = edf->items[0].deadline;
+    return true;
+}
+
+// *****************************************************************************
+// Private function implementations
+
+static bool is_before(const mu_sched_edf_entry_t *a,
+                      const mu_sched_edf_entry_t *b) {
+    // Same ordering as timed events: deadline first, then arrival
+    return mu_event_key_is_before(a->deadline, a->seq, b->deadline, b->seq);
+}
@@ -0,0 +1,397 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_exec.c
+ * @brief Work-stealing thread pool built from mu_sched instances.
+ *
+ * Each worker's ready ring has a single producer (the owning worker, filling
+ * it from its scheduler) and many consumers (the owner plus any thieves), all
+ * of which take from the top with a compare-and-swap.  Taking from the top on
+ * both paths keeps thunks first-in, first-out, as they are in mu_sched_step().
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_sched_exec.h"
+#include "mu_sched.h"
+#include "mu_sched_mpsc.h"
+#include "mu_thunk.h"
+#include "mu_time.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#if !defined(__GNUC__)
+#error "mu_sched_exec requires the GNU __atomic builtins"
+#endif
+
+// *****************************************************************************
+// Private data
+
+/** The worker running on the calling thread, if any. */
+static _Thread_local mu_sched_exec_worker_t *s_current_worker;
+
+// *****************************************************************************
+// Private function prototypes
+
+static void *worker_main(void *arg);
+
+/**
+ * @brief Marks `thunk` as running on this worker.  Returns false, leaving no
+ * mark, if a sibling is already running it.
+ */
+static bool claim(mu_sched_exec_worker_t *worker, mu_thunk_t *thunk);
+
+/**
+ * @brief Moves ready thunks from the worker's scheduler into its ready ring.
+ * Returns true if any were moved.
+ */
+static bool refill(mu_sched_exec_worker_t *worker);
+
+/**
+ * @brief Takes a thunk from a sibling's ready ring.
+ */
+static bool steal(mu_sched_exec_worker_t *worker, mu_thunk_t **thunk,
+                  void **args);
+
+/**
+ * @brief Sleeps until work may be available, a timed event on this worker
+ * falls due, or MU_SCHED_EXEC_MAX_PARK_NS elapses.
+ */
+static void park(mu_sched_exec_worker_t *worker);
+
+static bool work_visible(mu_sched_exec_worker_t *worker);
+static void wake_parked(mu_sched_exec_t *exec);
+
+/**
+ * @brief Ready ring helpers.  ready_push() is called by the owner only;
+ * ready_take() by any thread.
+ */
+static size_t ready_room(mu_sched_exec_worker_t *worker);
+static void ready_push(mu_sched_exec_worker_t *worker, mu_thunk_t *thunk,
+                       void *args);
+static bool ready_take(mu_sched_exec_worker_t *worker, mu_thunk_t **thunk,
+                       void **args);
+static bool ready_is_empty(mu_sched_exec_worker_t *worker);
+
+// *****************************************************************************
+// Public function implementations
+
+bool mu_sched_exec_worker_init(mu_sched_exec_worker_t *worker,
+                               mu_sched_t *sched, mu_sched_mpsc_t *remote_q,
+                               mu_sched_exec_slot_t *ready,
+                               size_t ready_capacity) {
+    if (!worker || !sched || !sched->initialized || !remote_q || !ready ||
+        ready_capacity == 0 || (ready_capacity & (ready_capacity - 1)) != 0) {
+        return false;
+    }
+    mu_sched_set_remote_queue_ex(sched, remote_q);
+    worker->sched = sched;
+    worker->ready = ready;
+    worker->mask = ready_capacity - 1;
+    worker->top = 0;
+    worker->bottom = 0;
+    worker->running = NULL;
+    worker->exec = NULL;
+    for (size_t i = 0; i < ready_capacity; i++) {
+        ready[i].thunk = NULL;
+        ready[i].args = NULL;
+    }
+    return true;
+}
+
+bool mu_sched_exec_init(mu_sched_exec_t *exec, mu_sched_exec_worker_t *workers,
+                        size_t worker_count) {
+    pthread_condattr_t attr;
+
+    if (!exec || !workers || worker_count == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < worker_count; i++) {
+        if (!workers[i].sched) {
+            return false; // not set up by mu_sched_exec_worker_init()
+        }
+        workers[i].exec = exec;
+    }
+    exec->workers = workers;
+    exec->worker_count = worker_count;
+    exec->running = false;
+    exec->next_post = 0;
+    exec->parked = 0;
+    exec->stopping = false;
+
+    if (pthread_mutex_init(&exec->park_lock, NULL) != 0) {
+        return false;
+    }
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    int err = pthread_cond_init(&exec->park_cond, &attr);
+    pthread_condattr_destroy(&attr);
+    if (err != 0) {
+        pthread_mutex_destroy(&exec->park_lock);
+        return false;
+    }
+    return true;
+}
+
+bool mu_sched_exec_start(mu_sched_exec_t *exec) {
+    if (!exec || exec->running) {
+        return false;
+    }
+    __atomic_store_n(&exec->stopping, false, __ATOMIC_SEQ_CST);
+    for (size_t i = 0; i < exec->worker_count; i++) {
+        mu_sched_exec_worker_t *worker = &exec->workers[i];
+        if (pthread_create(&worker->thread, NULL, worker_main, worker) != 0) {
+            // Unwind the threads that did start
+            __atomic_store_n(&exec->stopping, true, __ATOMIC_SEQ_CST);
+            wake_parked(exec);
+            while (i-- > 0) {
+                pthread_join(exec->workers[i].thread, NULL);
+            }
+            return false;
+        }
+    }
+    exec->running = true;
+    return true;
+}
+
+void mu_sched_exec_stop(mu_sched_exec_t *exec) {
+    if (!exec || !exec->running) {
+        return;
+    }
+    __atomic_store_n(&exec->stopping, true, __ATOMIC_SEQ_CST);
+    pthread_mutex_lock(&exec->park_lock);
+    pthread_cond_broadcast(&exec->park_cond);
+    pthread_mutex_unlock(&exec->park_lock);
+    for (size_t i = 0; i < exec->worker_count; i++) {
+        pthread_join(exec->workers[i].thread, NULL);
+    }
+    exec->running = false;
+}
+
+bool mu_sched_exec_post(mu_sched_exec_t *exec, mu_thunk_t *thunk) {
+    if (!exec || !thunk) {
+        return false;
+    }
+    size_t n = exec->worker_count;
+    size_t start = __atomic_fetch_add(&exec->next_post, 1, __ATOMIC_RELAXED);
+    for (size_t i = 0; i < n; i++) {
+        mu_sched_t *sched = exec->workers[(start + i) % n].sched;
+        if (mu_sched_post_remote_ex(sched, thunk)) {
+            wake_parked(exec);
+            return true;
+        }
+    }
+    return false;
+}
+
+mu_sched_t *mu_sched_exec_current(void) {
+    return s_current_worker ? s_current_worker->sched : NULL;
+}
+
+// *****************************************************************************
+// Private function implementations
+
+static void *worker_main(void *arg) {
+    mu_sched_exec_worker_t *worker = (mu_sched_exec_worker_t *)arg;
+    mu_sched_exec_t *exec = worker->exec;
+    mu_thunk_t *thunk;
+    void *args;
+
+    s_current_worker = worker;
+    while (!__atomic_load_n(&exec->stopping, __ATOMIC_RELAXED)) {
+        if (refill(worker)) {
+            wake_parked(exec);
+        }
+        if (ready_take(worker, &thunk, &args) ||
+            steal(worker, &thunk, &args)) {
+            if (!claim(worker, thunk)) {
+                // A sibling is running another copy: requeue behind the
+                // rest.  The take above left at least one free slot.
+                ready_push(worker, thunk, args);
+                continue;
+            }
+            // Stolen thunks run as the thief's current thunk, so anything
+            // they schedule lands on the thief.
+            mu_sched_run_args_ex(worker->sched, thunk, args);
+            __atomic_store_n(&worker->running, NULL, __ATOMIC_RELEASE);
+        } else {
+            park(worker);
+        }
+    }
+    s_current_worker = NULL;
+    return NULL;
+}
+
+static bool claim(mu_sched_exec_worker_t *worker, mu_thunk_t *thunk) {
+    mu_sched_exec_t *exec = worker->exec;
+
+    // Publish, then look: of two workers claiming the same thunk at once, at
+    // least one sees the other and backs off.
+    __atomic_store_n(&worker->running, thunk, __ATOMIC_SEQ_CST);
+    for (size_t i = 0; i < exec->worker_count; i++) {
+        mu_sched_exec_worker_t *other = &exec->workers[i];
+        if (other != worker &&
+            __atomic_load_n(&other->running, __ATOMIC_SEQ_CST) == thunk) {
+            __atomic_store_n(&worker->running, NULL, __ATOMIC_RELAXED);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool refill(mu_sched_exec_worker_t *worker) {
+    mu_thunk_t *thunk;
+    void *args;
+    size_t room = ready_room(worker);
+    bool moved = false;
+
+    // Room only grows while we fill: no one else pushes to this ring.
+    while (room > 0 &&
+           mu_sched_take_ready_args_ex(worker->sched, &thunk, &args)) {
+        ready_push(worker, thunk, args);
+        room--;
+        moved = true;
+    }
+    return moved;
+}
+
+static bool steal(mu_sched_exec_worker_t *worker, mu_thunk_t **thunk,
+                  void **args) {
+    mu_sched_exec_t *exec = worker->exec;
+    size_t n = exec->worker_count;
+    size_t self = (size_t)(worker - exec->workers);
+
+    for (size_t i = 1; i < n; i++) {
+        if (ready_take(&exec->workers[(self + i) % n], thunk, args)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void park(mu_sched_exec_worker_t *worker) {
+    mu_sched_exec_t *exec = worker->exec;
+    mu_time_rel_t timeout;
+    int64_t wait_ns = MU_SCHED_EXEC_MAX_PARK_NS;
+    struct timespec deadline;
+
+    if (mu_sched_idle_timeout_ex(worker->sched, &timeout)) {
+        if (timeout <= 0) {
+            return;
+        }
+        if ((int64_t)timeout < wait_ns) {
+            wait_ns = (int64_t)timeout;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_nsec += (long)wait_ns;
+    while (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_nsec -= 1000000000L;
+        deadline.tv_sec++;
+    }
+
+    pthread_mutex_lock(&exec->park_lock);
+    __atomic_fetch_add(&exec->parked, 1, __ATOMIC_SEQ_CST);
+    // Pairs with the fence in wake_parked(): either the poster sees us parked
+    // or we see its work.  Should a wake-up still be missed, the bounded wait
+    // keeps the cost to one park interval.
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (!__atomic_load_n(&exec->stopping, __ATOMIC_SEQ_CST) &&
+        !work_visible(worker)) {
+        pthread_cond_timedwait(&exec->park_cond, &exec->park_lock, &deadline);
+    }
+    __atomic_fetch_sub(&exec->parked, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&exec->park_lock);
+}
+
+static bool work_visible(mu_sched_exec_worker_t *worker) {
+    mu_sched_exec_t *exec = worker->exec;
+
+    if (mu_sched_has_runnable_thunk_ex(worker->sched)) {
+        return true;
+    }
+    for (size_t i = 0; i < exec->worker_count; i++) {
+        if (!ready_is_empty(&exec->workers[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void wake_parked(mu_sched_exec_t *exec) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&exec->parked, __ATOMIC_RELAXED) > 0) {
+        pthread_mutex_lock(&exec->park_lock);
+        pthread_cond_broadcast(&exec->park_cond);
+        pthread_mutex_unlock(&exec->park_lock);
+    }
+}
+
+static size_t ready_room(mu_sched_exec_worker_t *worker) {
+    size_t bottom = __atomic_load_n(&worker->bottom, __ATOMIC_RELAXED);
+    size_t top = __atomic_load_n(&worker->top, __ATOMIC_ACQUIRE);
+    return worker->mask + 1 - (bottom - top);
+}
+
+static void ready_push(mu_sched_exec_worker_t *worker, mu_thunk_t *thunk,
+                       void *args) {
+    size_t bottom = __atomic_load_n(&worker->bottom, __ATOMIC_RELAXED);
+    mu_sched_exec_slot_t *slot = &worker->ready[bottom & worker->mask];
+    __atomic_store_n(&slot->thunk, thunk, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->args, args, __ATOMIC_RELAXED);
+    __atomic_store_n(&worker->bottom, bottom + 1, __ATOMIC_RELEASE);
+}
+
+static bool ready_take(mu_sched_exec_worker_t *worker, mu_thunk_t **thunk,
+                       void **args) {
+    size_t top = __atomic_load_n(&worker->top, __ATOMIC_ACQUIRE);
+    for (;;) {
+        size_t bottom = __atomic_load_n(&worker->bottom, __ATOMIC_ACQUIRE);
+        if (top == bottom) {
+            return false;
+        }
+        // If the owner has recycled this slot meanwhile, top has moved on
+        // and the exchange below fails.
+        mu_sched_exec_slot_t *slot = &worker->ready[top & worker->mask];
+        mu_thunk_t *item = __atomic_load_n(&slot->thunk, __ATOMIC_RELAXED);
+        void *item_args = __atomic_load_n(&slot->args, __ATOMIC_RELAXED);
+        if (__atomic_compare_exchange_n(&worker->top, &top, top + 1, true,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            *thunk = item;
+            *args = item_args;
+            return true;
+        }
+    }
+}
+
+static bool ready_is_empty(mu_sched_exec_worker_t *worker) {
+    return __atomic_load_n(&worker->top, __ATOMIC_ACQUIRE) ==
+           __atomic_load_n(&worker->bottom, __ATOMIC_ACQUIRE);
+}
@@ -0,0 +1,249 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_heap.c
+ * @brief d-ary min-heap event store for mu_sched.
+ *
+ * The children of node i are nodes D*i+1 .. D*i+D and its parent is node
+ * (i-1)/D, where D is MU_SCHED_HEAP_ARITY.  Every move through place() and
+ * move() keeps mu_event_t.index equal to the event's position in `items`,
+ * and, in a keyed heap, `keys[i]` equal to the key of `items[i]`.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_sched_heap.h"
+#include "mu_event.h"
+#include "mu_thunk.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// Private function prototypes
+
+static mu_sched_heap_key_t key_of(const mu_event_t *evt);
+
+/**
+ * @brief Returns the key of the event in slot i, from `keys` if the heap is
+ * keyed, else from the event itself.
+ */
+static mu_sched_heap_key_t slot_key(const mu_sched_heap_t *heap, size_t i);
+
+static bool key_is_before(const mu_sched_heap_key_t *a,
+                          const mu_sched_heap_key_t *b);
+
+static void place(mu_sched_heap_t *heap, mu_event_t *evt,
+                  const mu_sched_heap_key_t *key, size_t i);
+static void move(mu_sched_heap_t *heap, size_t from, size_t to);
+
+/**
+ * @brief Moves `evt`, whose key is `key`, from slot i towards the root / the
+ * leaves until the heap property holds again.
+ */
+static void sift_up(mu_sched_heap_t *heap, mu_event_t *evt,
+                    mu_sched_heap_key_t key, size_t i);
+static void sift_down(mu_sched_heap_t *heap, mu_event_t *evt,
+                      mu_sched_heap_key_t key, size_t i);
+
+// *****************************************************************************
+// Public function implementations
+
+mu_sched_heap_t *mu_sched_heap_init(mu_sched_heap_t *heap, mu_event_t **store,
+                                    size_t capacity) {
+    return mu_sched_heap_init_keyed(heap, store, NULL, capacity);
+}
+
+mu_sched_heap_t *mu_sched_heap_init_keyed(mu_sched_heap_t *heap,
+                                          mu_event_t **store,
+                                          mu_sched_heap_key_t *keys,
+                                          size_t capacity) {
+    if (!heap || !store || capacity == 0) {
+        return NULL;
+    }
+    heap->items = store;
+    heap->keys = keys;
+    heap->capacity = capacity;
+    heap->count = 0;
+    return heap;
+}
+
+size_t mu_sched_heap_count(const mu_sched_heap_t *heap) {
+    return heap->count;
+}
+
+size_t mu_sched_heap_capacity(const mu_sched_heap_t *heap) {
+    return heap->capacity;
+}
+
+bool mu_sched_heap_insert(mu_sched_heap_t *heap, mu_event_t *evt) {
+    if (heap->count == heap->capacity) {
+        return false;
+    }
+    sift_up(heap, evt, key_of(evt), heap->count++);
+    return true;
+}
+
+mu_event_t *mu_sched_heap_peek(const mu_sched_heap_t *heap) {
+    return heap->count ? heap->items[0] : NULL;
+}
+
+mu_event_t *mu_sched_heap_pop(mu_sched_heap_t *heap) {
+    mu_event_t *evt = mu_sched_heap_peek(heap);
+    if (evt) {
+        mu_sched_heap_remove(heap, evt);
+    }
+    return evt;
+}
+
+void mu_sched_heap_remove(mu_sched_heap_t *heap, mu_event_t *evt) {
+    size_t i = evt->index;
+    mu_event_t *last = heap->items[--heap->count];
+
+    if (last == evt) {
+        return; // it was the last slot
+    }
+    // Refill the hole with the last event, which may belong above or below it
+    mu_sched_heap_key_t key = slot_key(heap, heap->count);
+    if (i > 0) {
+        mu_sched_heap_key_t parent =
+            slot_key(heap, (i - 1) / MU_SCHED_HEAP_ARITY);
+        if (key_is_before(&key, &parent)) {
+            sift_up(heap, last, key, i);
+            return;
+        }
+    }
+    sift_down(heap, last, key, i);
+}
+
+mu_event_t *mu_sched_heap_remove_thunk(mu_sched_heap_t *heap,
+                                       const mu_thunk_t *thunk) {
+    mu_event_t *removed = NULL;
+    size_t kept = 0;
+
+    // Compact the survivors, then restore the heap bottom-up (Floyd).
+    for (size_t i = 0; i < heap->count; i++) {
+        mu_event_t *evt = heap->items[i];
+        bool match = heap->keys ? heap->keys[i].thunk == thunk
+                                : evt->thunk == thunk;
+        if (match) {
+            evt->next = removed; // index is no longer needed
+            removed = evt;
+        } else {
+            move(heap, i, kept++);
+        }
+    }
+    heap->count = kept;
+    for (size_t i = kept / MU_SCHED_HEAP_ARITY + 1; i-- > 0;) {
+        if (i < kept) {
+            sift_down(heap, heap->items[i], slot_key(heap, i), i);
+        }
+    }
+    return removed;
+}
+
+void mu_sched_heap_visit(const mu_sched_heap_t *heap, mu_event_visit_fn fn,
+                         void *ctx) {
+    for (size_t i = 0; i < heap->count; i++) {
+        fn(heap->items[i], ctx);
+    }
+}
+
+// *****************************************************************************
+// Private function implementations
+
+static mu_sched_heap_key_t key_of(const mu_event_t *evt) {
+    return (mu_sched_heap_key_t){evt->timestamp, evt->seq, evt->thunk};
+}
+
+static mu_sched_heap_key_t slot_key(const mu_sched_heap_t *heap, size_t i) {
+    return heap->keys ? heap->keys[i] : key_of(heap->items[i]);
+}
+
+static bool key_is_before(const mu_sched_heap_key_t *a,
+                          const mu_sched_heap_key_t *b) {
+    return mu_event_key_is_before(a->timestamp, a->seq, b->timestamp, b->seq);
+}
+
+static void place(mu_sched_heap_t *heap, mu_event_t *evt,
+                  const mu_sched_heap_key_t *key, size_t i) {
+    heap->items[i] = evt;
+    evt->index = i;
+    if (heap->keys) {
+        heap->keys[i] = *key;
+    }
+}
+
+static void move(mu_sched_heap_t *heap, size_t from, size_t to) {
+    heap->items[to] = heap->items[from];
+    heap->items[to]->index = to;
+    if (heap->keys) {
+        heap->keys[to] = heap->keys[from];
+    }
+}
+
+static void sift_up(mu_sched_heap_t *heap, mu_event_t *evt,
+                    mu_sched_heap_key_t key, size_t i) {
+    while (i > 0) {
+        size_t parent = (i - 1) / MU_SCHED_HEAP_ARITY;
+        mu_sched_heap_key_t parent_key = slot_key(heap, parent);
+        if (!key_is_before(&key, &parent_key)) {
+            break;
+        }
+        move(heap, parent, i);
+        i = parent;
+    }
+    place(heap, evt, &key, i);
+}
+
+static void sift_down(mu_sched_heap_t *heap, mu_event_t *evt,
+                      mu_sched_heap_key_t key, size_t i) {
+    for (;;) {
+        size_t first = i * MU_SCHED_HEAP_ARITY + 1;
+        if (first >= heap->count) {
+            break;
+        }
+        size_t end = first + MU_SCHED_HEAP_ARITY;
+        if (end > heap->count) {
+            end = heap->count;
+        }
+        size_t best = first;
+        mu_sched_heap_key_t best_key = slot_key(heap, first);
+        for (size_t c = first + 1; c < end; c++) {
+            mu_sched_heap_key_t c_key = slot_key(heap, c);
+            if (key_is_before(&c_key, &best_key)) {
+                best = c;
+                best_key = c_key;
+            }
+        }
+        if (!key_is_before(&best_key, &key)) {
+            break;
+        }
+        move(heap, best, i);
+        i = best;
+    }
+    place(heap, evt, &key, i);
+}
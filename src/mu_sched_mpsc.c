@@ -0,0 +1,146 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_mpsc.c
+ * @brief Lock-free multi-producer, single-consumer thunk queue for mu_sched.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_sched_mpsc.h"
+#include <stdbool.h>
+#include <stddef.h>
+#if !defined(__GNUC__)
+#include <stdatomic.h>
+#endif
+
+// *****************************************************************************
+// Private types and definitions
+
+// Atomic access to the volatile fields of the public types: slot items are
+// pointers, `reserved` and `tail` are sizes.
+#if defined(__GNUC__)
+#define ITEM_LOAD(p, order) __atomic_load_n((p), __ATOMIC_##order)
+#define ITEM_STORE(p, v, order) __atomic_store_n((p), (v), __ATOMIC_##order)
+#define SIZE_FETCH_ADD(p, v, order)                                            \
+    __atomic_fetch_add((p), (v), __ATOMIC_##order)
+#define SIZE_FETCH_SUB(p, v, order)                                            \
+    __atomic_fetch_sub((p), (v), __ATOMIC_##order)
+#else
+#define ORDER_RELAXED memory_order_relaxed
+#define ORDER_ACQUIRE memory_order_acquire
+#define ORDER_RELEASE memory_order_release
+#define ITEM_LOAD(p, order)                                                    \
+    atomic_load_explicit((_Atomic(void *) *)(p), ORDER_##order)
+#define ITEM_STORE(p, v, order)                                                \
+    atomic_store_explicit((_Atomic(void *) *)(p), (v), ORDER_##order)
+#define SIZE_FETCH_ADD(p, v, order)                                            \
+    atomic_fetch_add_explicit((atomic_size_t *)(p), (v), ORDER_##order)
+#define SIZE_FETCH_SUB(p, v, order)                                            \
+    atomic_fetch_sub_explicit((atomic_size_t *)(p), (v), ORDER_##order)
+#endif
+
+// *****************************************************************************
+// Public function implementations
+
+mu_sched_mpsc_err_t mu_sched_mpsc_init(mu_sched_mpsc_t *q,
+                                       mu_sched_mpsc_slot_t *store,
+                                       size_t capacity) {
+    if (!q || !store || capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return MU_SCHED_MPSC_ERR_SIZE;
+    }
+    q->store = store;
+    q->mask = capacity - 1;
+    q->head = 0;
+    q->reserved = 0;
+    q->tail = 0;
+    for (size_t i = 0; i < capacity; i++) {
+        store[i].item = NULL;
+        store[i].args = NULL;
+    }
+    return MU_SCHED_MPSC_ERR_NONE;
+}
+
+mu_sched_mpsc_err_t mu_sched_mpsc_put(mu_sched_mpsc_t *q, void *item) {
+    return mu_sched_mpsc_put_args(q, item, NULL);
+}
+
+mu_sched_mpsc_err_t mu_sched_mpsc_put_args(mu_sched_mpsc_t *q, void *item,
+                                           void *args) {
+    // Reserve capacity first.  While `reserved` never exceeds the capacity,
+    // the slot handed out below has already been drained by the consumer:
+    // every older slot still occupied is backed by another reservation.
+    size_t held = SIZE_FETCH_ADD(&q->reserved, 1, ACQUIRE);
+    if (held > q->mask) {
+        SIZE_FETCH_SUB(&q->reserved, 1, RELAXED);
+        return MU_SCHED_MPSC_ERR_FULL;
+    }
+    size_t index = SIZE_FETCH_ADD(&q->tail, 1, RELAXED);
+    mu_sched_mpsc_slot_t *slot = &q->store[index & q->mask];
+    // The release below publishes args together with the item
+    slot->args = args;
+    ITEM_STORE(&slot->item, item, RELEASE);
+    return MU_SCHED_MPSC_ERR_NONE;
+}
+
+mu_sched_mpsc_err_t mu_sched_mpsc_get(mu_sched_mpsc_t *q, void **item) {
+    void *args;
+    return mu_sched_mpsc_get_args(q, item, &args);
+}
+
+mu_sched_mpsc_err_t mu_sched_mpsc_get_args(mu_sched_mpsc_t *q, void **item,
+                                           void **args) {
+    mu_sched_mpsc_slot_t *slot = &q->store[q->head & q->mask];
+    void *value = ITEM_LOAD(&slot->item, ACQUIRE);
+    if (value == NULL) {
+        // Empty, or the producer that owns this slot has not published yet
+        return MU_SCHED_MPSC_ERR_EMPTY;
+    }
+    *args = slot->args;
+    ITEM_STORE(&slot->item, NULL, RELAXED);
+    q->head++;
+    // Release: the slot must read as empty before a producer can reclaim it
+    SIZE_FETCH_SUB(&q->reserved, 1, RELEASE);
+    *item = value;
+    return MU_SCHED_MPSC_ERR_NONE;
+}
+
+mu_sched_mpsc_err_t mu_sched_mpsc_peek_args(mu_sched_mpsc_t *q, void **item,
+                                            void **args) {
+    mu_sched_mpsc_slot_t *slot = &q->store[q->head & q->mask];
+    void *value = ITEM_LOAD(&slot->item, ACQUIRE);
+    if (value == NULL) {
+        return MU_SCHED_MPSC_ERR_EMPTY;
+    }
+    *args = slot->args;
+    *item = value;
+    return MU_SCHED_MPSC_ERR_NONE;
+}
+
+bool mu_sched_mpsc_is_empty(mu_sched_mpsc_t *q) {
+    return ITEM_LOAD(&q->store[q->head & q->mask].item, ACQUIRE) == NULL;
+}
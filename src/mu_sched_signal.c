@@ -0,0 +1,167 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_signal.c
+ * @brief Signals that wake a batch of waiting thunks.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_sched_signal.h"
+#include "mu_sched.h"
+#include "mu_thunk.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#if !defined(__GNUC__)
+#include <stdatomic.h>
+#endif
+
+// *****************************************************************************
+// Private types and definitions
+
+// Atomic test-and-set / clear of mu_sched_signal_t.isr_pending, a plain byte
+// in the public header so that it stays usable from C++.
+#if defined(__GNUC__)
+#define PENDING_TEST_AND_SET(flag)                                             \
+    __atomic_test_and_set((flag), __ATOMIC_ACQ_REL)
+#define PENDING_CLEAR(flag) __atomic_clear((flag), __ATOMIC_RELEASE)
+#else
+#define PENDING_TEST_AND_SET(flag)                                             \
+    (atomic_exchange((_Atomic uint8_t *)(flag), 1) != 0)
+#define PENDING_CLEAR(flag) atomic_store((_Atomic uint8_t *)(flag), 0)
+#endif
+
+// *****************************************************************************
+// Private function prototypes
+
+/**
+ * @brief Runs on the scheduler thread after mu_sched_signal_raise_from_isr().
+ */
+static void isr_raise_fn(mu_thunk_t *thunk, void *args);
+
+// *****************************************************************************
+// Public function implementations
+
+mu_sched_signal_t *mu_sched_signal_init(mu_sched_signal_t *sig,
+                                        mu_thunk_t **waiters,
+                                        size_t capacity) {
+    if (!sig || !waiters || capacity == 0) {
+        return NULL;
+    }
+    mu_thunk_init(&sig->isr_thunk, isr_raise_fn);
+    sig->waiters = waiters;
+    sig->capacity = capacity;
+    sig->count = 0;
+    sig->isr_sched = NULL;
+    sig->isr_pending = 0;
+    return sig;
+}
+
+bool mu_sched_signal_wait(mu_sched_signal_t *sig, mu_thunk_t *thunk) {
+    if (!sig || !thunk || sig->count == sig->capacity) {
+        return false;
+    }
+    sig->waiters[sig->count++] = thunk;
+    return true;
+}
+
+size_t mu_sched_signal_remove(mu_sched_signal_t *sig,
+                              const mu_thunk_t *thunk) {
+    size_t kept = 0;
+    size_t removed;
+
+    if (!sig) {
+        return 0;
+    }
+    for (size_t i = 0; i < sig->count; i++) {
+        if (sig->waiters[i] != thunk) {
+            sig->waiters[kept++] = sig->waiters[i];
+        }
+    }
+    removed = sig->count - kept;
+    sig->count = kept;
+    return removed;
+}
+
+size_t mu_sched_signal_waiter_count(const mu_sched_signal_t *sig) {
+    return sig ? sig->count : 0;
+}
+
+size_t mu_sched_signal_raise_ex(mu_sched_t *sched, mu_sched_signal_t *sig) {
+    size_t n;
+    size_t kept = 0;
+
+    if (!sched || !sig) {
+        return 0;
+    }
+    // Waiters registered while waking (by a woken thunk, later) wait for the
+    // next raise, so only the current list is visited.
+    n = sig->count;
+    for (size_t i = 0; i < n; i++) {
+        if (!mu_sched_now_ex(sched, sig->waiters[i])) {
+            sig->waiters[kept++] = sig->waiters[i];
+        }
+    }
+    sig->count = kept;
+    return n - kept;
+}
+
+bool mu_sched_signal_raise_from_isr_ex(mu_sched_t *sched,
+                                       mu_sched_signal_t *sig) {
+    if (!sched || !sig) {
+        return false;
+    }
+    if (PENDING_TEST_AND_SET(&sig->isr_pending)) {
+        return true; // coalesce with the raise already queued
+    }
+    sig->isr_sched = sched;
+    if (!mu_sched_from_isr_ex(sched, &sig->isr_thunk)) {
+        PENDING_CLEAR(&sig->isr_pending);
+        return false;
+    }
+    return true;
+}
+
+size_t mu_sched_signal_raise(mu_sched_signal_t *sig) {
+    return mu_sched_signal_raise_ex(mu_sched_default(), sig);
+}
+
+bool mu_sched_signal_raise_from_isr(mu_sched_signal_t *sig) {
+    return mu_sched_signal_raise_from_isr_ex(mu_sched_default(), sig);
+}
+
+// *****************************************************************************
+// Private function implementations
+
+static void isr_raise_fn(mu_thunk_t *thunk, void *args) {
+    mu_sched_signal_t *sig = (mu_sched_signal_t *)thunk;
+    (void)args;
+    // Clear first: a raise from an ISR during the wake-up queues another pass
+    PENDING_CLEAR(&sig->isr_pending);
+    mu_sched_signal_raise_ex(sig->isr_sched, sig);
+}
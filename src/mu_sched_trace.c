@@ -0,0 +1,123 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_trace.c
+ * @brief Wait-free binary trace ring for scheduler events.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_sched_trace.h"
+#include "mu_time.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#if !defined(__GNUC__)
+#include <stdatomic.h>
+#endif
+
+// *****************************************************************************
+// Private types and definitions
+
+// Loads and stores of mu_sched_trace_t.head; see MU_SCHED_TRACE_CLAIM()
+#if defined(__GNUC__)
+#define HEAD_LOAD(head) __atomic_load_n((head), __ATOMIC_ACQUIRE)
+#define HEAD_STORE(head, value)                                                \
+    __atomic_store_n((head), (value), __ATOMIC_RELAXED)
+#else
+#define HEAD_LOAD(head) atomic_load((_Atomic uint32_t *)(head))
+#define HEAD_STORE(head, value)                                                \
+    atomic_store((_Atomic uint32_t *)(head), (value))
+#endif
+
+// *****************************************************************************
+// Private function prototypes
+
+/**
+ * @brief Default trace clock: microseconds from mu_time_now(), modulo 2^32.
+ */
+static uint32_t default_clock(void);
+
+// *****************************************************************************
+// Public function implementations
+
+bool mu_sched_trace_init(mu_sched_trace_t *trace,
+                         mu_sched_trace_record_t *records, size_t capacity,
+                         mu_sched_trace_clock_t clock,
+                         uint32_t ticks_per_second) {
+    if (!trace || !records || capacity == 0 || capacity > UINT32_MAX ||
+        (capacity & (capacity - 1)) != 0 || (clock && ticks_per_second == 0)) {
+        return false;
+    }
+    trace->records = records;
+    trace->mask = (uint32_t)(capacity - 1);
+    trace->clock = clock ? clock : default_clock;
+    trace->ticks_per_second = clock ? ticks_per_second : 1000000U;
+    trace->head = 0;
+    trace->full = false;
+    return true;
+}
+
+size_t mu_sched_trace_count(const mu_sched_trace_t *trace) {
+    uint32_t head = HEAD_LOAD(&trace->head);
+    return trace->full || head > trace->mask ? (size_t)trace->mask + 1 : head;
+}
+
+void mu_sched_trace_clear(mu_sched_trace_t *trace) {
+    HEAD_STORE(&trace->head, 0);
+    trace->full = false;
+}
+
+size_t mu_sched_trace_write(const mu_sched_trace_t *trace,
+                            mu_sched_trace_write_fn write, void *ctx) {
+    uint32_t head = HEAD_LOAD(&trace->head);
+    uint32_t count = (uint32_t)mu_sched_trace_count(trace);
+    mu_sched_trace_header_t header = {
+        .magic = MU_SCHED_TRACE_MAGIC,
+        .version = MU_SCHED_TRACE_VERSION,
+        .record_size = sizeof(mu_sched_trace_record_t),
+        .ticks_per_second = trace->ticks_per_second,
+        .count = count,
+    };
+    size_t written = write(ctx, &header, sizeof(header));
+
+    // Oldest first: the ring may have wrapped around many times
+    for (uint32_t seq = head - count; seq != head; seq++) {
+        written += write(ctx, &trace->records[seq & trace->mask],
+                         sizeof(mu_sched_trace_record_t));
+    }
+    return written;
+}
+
+// *****************************************************************************
+// Private function implementations
+
+static uint32_t default_clock(void) {
+    mu_time_abs_t now = mu_time_now();
+    return (uint32_t)((uint64_t)now.seconds * 1000000U +
+                      (uint64_t)now.nanoseconds / 1000U);
+}
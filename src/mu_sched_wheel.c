@@ -0,0 +1,409 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_wheel.c
+ * @brief Hierarchical timer wheel event store for mu_sched.
+ *
+ * Placement invariant: an event with tick `e` later than the cursor `c` lives
+ * at the level of the most significant MU_SCHED_WHEEL_BITS-wide digit in which
+ * `e` and `c` differ, in the slot given by that digit of `e`.  Consequently,
+ * when the cursor advances to `n`, and `L` is the level of the highest digit
+ * in which `c` and `n` differ:
+ *
+ * - every event on a level below `L` is due,
+ * - on level `L`, slots after the cursor's digit and up to `n`'s digit must be
+ *   revisited (events in the last of them may cascade to a lower level),
+ * - levels above `L` are untouched.
+ *
+ * Each event therefore moves at most once per level before it expires.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_sched_wheel.h"
+#include "mu_event.h"
+#include "mu_thunk.h"
+#include "mu_time.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define WHEEL_MASK ((uint64_t)MU_SCHED_WHEEL_SLOTS - 1)
+
+#define NS_PER_SECOND 1000000000u
+
+// *****************************************************************************
+// Private function prototypes
+
+static uint64_t tick_of(const mu_sched_wheel_t *wheel, mu_time_abs_t t);
+static uint64_t event_tick_of(const mu_sched_wheel_t *wheel,
+                              const mu_event_t *evt);
+static unsigned msb64(uint64_t x);
+static unsigned lsb64(uint64_t x);
+static void list_push(mu_event_t **head, mu_event_t *evt);
+static void list_unlink(mu_event_t *evt);
+static void list_relink(mu_event_t **head);
+static mu_event_t *list_merge(mu_event_t *a, mu_event_t *b);
+static mu_event_t *list_sort(mu_event_t *list);
+static void place(mu_sched_wheel_t *wheel, mu_event_t *evt, uint64_t tick);
+static void expire_insert(mu_sched_wheel_t *wheel, mu_event_t *evt);
+static void redistribute(mu_sched_wheel_t *wheel, mu_event_t **list,
+                         mu_event_t **due);
+static void take_slots(mu_sched_wheel_t *wheel, unsigned level, uint64_t mask,
+                       mu_event_t **due);
+static void take_matching(mu_event_t **head, mu_thunk_t *thunk,
+                          mu_event_t **removed);
+static mu_event_t *list_earliest(mu_event_t *list);
+static void visit_list(const mu_event_t *list, mu_event_visit_fn fn,
+                       void *ctx);
+
+// *****************************************************************************
+// Public function implementations
+
+mu_sched_wheel_t *mu_sched_wheel_init(mu_sched_wheel_t *wheel,
+                                      uint32_t ns_per_tick) {
+    if (!wheel || ns_per_tick == 0) {
+        return NULL;
+    }
+    memset(wheel, 0, sizeof(*wheel));
+    wheel->ns_per_tick = ns_per_tick;
+    return wheel;
+}
+
+size_t mu_sched_wheel_count(const mu_sched_wheel_t *wheel) {
+    return wheel->count;
+}
+
+void mu_sched_wheel_insert(mu_sched_wheel_t *wheel, mu_event_t *evt) {
+    place(wheel, evt, event_tick_of(wheel, evt));
+    wheel->count++;
+}
+
+void mu_sched_wheel_advance(mu_sched_wheel_t *wheel, mu_time_abs_t now) {
+    uint64_t from = wheel->cursor;
+    uint64_t to = tick_of(wheel, now);
+    if (to <= from) {
+        return;
+    }
+
+    unsigned top = msb64(from ^ to) / MU_SCHED_WHEEL_BITS;
+    mu_event_t *due = NULL;
+
+    wheel->cursor = to;
+    if (top >= MU_SCHED_WHEEL_LEVELS) {
+        // Every level has wrapped: revisit everything, including overflow.
+        for (unsigned level = 0; level < MU_SCHED_WHEEL_LEVELS; level++) {
+            take_slots(wheel, level, ~(uint64_t)0, &due);
+        }
+        redistribute(wheel, &wheel->overflow, &due);
+    } else {
+        for (unsigned level = 0; level < top; level++) {
+            take_slots(wheel, level, ~(uint64_t)0, &due);
+        }
+        unsigned shift = top * MU_SCHED_WHEEL_BITS;
+        unsigned lo = (unsigned)((from >> shift) & WHEEL_MASK);
+        unsigned hi = (unsigned)((to >> shift) & WHEEL_MASK);
+        // slots in (lo, hi]
+        uint64_t mask = ((((uint64_t)2) << hi) - 1) &
+                        ~((((uint64_t)2) << lo) - 1);
+        take_slots(wheel, top, mask, &due);
+    }
+
+    if (due) {
+        // Merge the newly due events into the (already sorted) expiry list.
+        wheel->expired = list_merge(wheel->expired, list_sort(due));
+        list_relink(&wheel->expired);
+    }
+}
+
+mu_event_t *mu_sched_wheel_peek(const mu_sched_wheel_t *wheel) {
+    return wheel->expired;
+}
+
+mu_event_t *mu_sched_wheel_pop(mu_sched_wheel_t *wheel) {
+    mu_event_t *evt = wheel->expired;
+    if (evt) {
+        list_unlink(evt);
+        wheel->count--;
+    }
+    return evt;
+}
+
+mu_event_t *mu_sched_wheel_earliest(const mu_sched_wheel_t *wheel) {
+    if (wheel->expired) {
+        // Expired events precede everything still on the wheel.
+        return wheel->expired;
+    }
+    // Each level's events precede those of the level above, and within a
+    // level, lower slots precede higher ones.
+    for (unsigned level = 0; level < MU_SCHED_WHEEL_LEVELS; level++) {
+        uint64_t bits = wheel->occupied[level];
+        while (bits) {
+            unsigned slot = lsb64(bits);
+            bits &= bits - 1;
+            mu_event_t *evt = list_earliest(wheel->slots[level][slot]);
+            if (evt) {
+                return evt;
+            }
+        }
+    }
+    return list_earliest(wheel->overflow);
+}
+
+void mu_sched_wheel_remove(mu_sched_wheel_t *wheel, mu_event_t *evt) {
+    // A slot's occupancy bit may now be stale; advance tolerates that.
+    list_unlink(evt);
+    wheel->count--;
+}
+
+mu_event_t *mu_sched_wheel_remove_thunk(mu_sched_wheel_t *wheel,
+                                        mu_thunk_t *thunk) {
+    mu_event_t *removed = NULL;
+    for (unsigned level = 0; level < MU_SCHED_WHEEL_LEVELS; level++) {
+        uint64_t bits = wheel->occupied[level];
+        while (bits) {
+            unsigned slot = lsb64(bits);
+            bits &= bits - 1;
+            take_matching(&wheel->slots[level][slot], thunk, &removed);
+        }
+    }
+    take_matching(&wheel->overflow, thunk, &removed);
+    take_matching(&wheel->expired, thunk, &removed);
+    for (mu_event_t *evt = removed; evt != NULL; evt = evt->next) {
+        wheel->count--;
+    }
+    return removed;
+}
+
+void mu_sched_wheel_visit(const mu_sched_wheel_t *wheel, mu_event_visit_fn fn,
+                          void *ctx) {
+    for (unsigned level = 0; level < MU_SCHED_WHEEL_LEVELS; level++) {
+        uint64_t bits = wheel->occupied[level];
+        while (bits) {
+            unsigned slot = lsb64(bits);
+            bits &= bits - 1;
+            visit_list(wheel->slots[level][slot], fn, ctx);
+        }
+    }
+    visit_list(wheel->overflow, fn, ctx);
+    visit_list(wheel->expired, fn, ctx);
+}
+
+// *****************************************************************************
+// Private function implementations
+
+static uint64_t tick_of(const mu_sched_wheel_t *wheel, mu_time_abs_t t) {
+    uint64_t ns = (uint64_t)t.seconds * NS_PER_SECOND + (uint64_t)t.nanoseconds;
+    return ns / wheel->ns_per_tick;
+}
+
+static uint64_t event_tick_of(const mu_sched_wheel_t *wheel,
+                              const mu_event_t *evt) {
+#ifdef MU_SCHED_TICK_EVENTS
+    return (uint64_t)evt->timestamp * MU_SCHED_TICK_NS / wheel->ns_per_tick;
+#else
+    return tick_of(wheel, evt->timestamp);
+#endif
+}
+
+static unsigned msb64(uint64_t x) {
+#if defined(__GNUC__)
+    return 63u - (unsigned)__builtin_clzll(x);
+#else
+    unsigned n = 0;
+    while (x >>= 1) {
+        n++;
+    }
+    return n;
+#endif
+}
+
+static unsigned lsb64(uint64_t x) {
+#if defined(__GNUC__)
+    return (unsigned)__builtin_ctzll(x);
+#else
+    unsigned n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static void list_push(mu_event_t **head, mu_event_t *evt) {
+    evt->next = *head;
+    if (evt->next) {
+        evt->next->pprev = &evt->next;
+    }
+    evt->pprev = head;
+    *head = evt;
+}
+
+static void list_unlink(mu_event_t *evt) {
+    *evt->pprev = evt->next;
+    if (evt->next) {
+        evt->next->pprev = evt->pprev;
+    }
+    evt->next = NULL;
+    evt->pprev = NULL;
+}
+
+static void list_relink(mu_event_t **head) {
+    for (mu_event_t **link = head; *link; link = &(*link)->next) {
+        (*link)->pprev = link;
+    }
+}
+
+static mu_event_t *list_merge(mu_event_t *a, mu_event_t *b) {
+    mu_event_t *out = NULL;
+    mu_event_t **link = &out;
+    while (a && b) {
+        if (mu_event_is_before(b, a)) {
+            *link = b;
+            b = b->next;
+        } else {
+            *link = a;
+            a = a->next;
+        }
+        link = &(*link)->next;
+    }
+    *link = a ? a : b;
+    return out;
+}
+
+static mu_event_t *list_sort(mu_event_t *list) {
+    if (!list || !list->next) {
+        return list;
+    }
+    // Split in half with slow/fast pointers, sort each half, merge.
+    mu_event_t *slow = list;
+    mu_event_t *fast = list->next;
+    while (fast && fast->next) {
+        slow = slow->next;
+        fast = fast->next->next;
+    }
+    mu_event_t *back = slow->next;
+    slow->next = NULL;
+    return list_merge(list_sort(list), list_sort(back));
+}
+
+static void place(mu_sched_wheel_t *wheel, mu_event_t *evt, uint64_t tick) {
+    if (tick <= wheel->cursor) {
+        expire_insert(wheel, evt);
+        return;
+    }
+    unsigned level = msb64(tick ^ wheel->cursor) / MU_SCHED_WHEEL_BITS;
+    if (level >= MU_SCHED_WHEEL_LEVELS) {
+        list_push(&wheel->overflow, evt);
+        return;
+    }
+    unsigned slot =
+        (unsigned)((tick >> (level * MU_SCHED_WHEEL_BITS)) & WHEEL_MASK);
+    list_push(&wheel->slots[level][slot], evt);
+    wheel->occupied[level] |= (uint64_t)1 << slot;
+}
+
+static void expire_insert(mu_sched_wheel_t *wheel, mu_event_t *evt) {
+    mu_event_t **link = &wheel->expired;
+    while (*link && !mu_event_is_before(evt, *link)) {
+        link = &(*link)->next;
+    }
+    evt->next = *link;
+    if (evt->next) {
+        evt->next->pprev = &evt->next;
+    }
+    evt->pprev = link;
+    *link = evt;
+}
+
+/**
+ * @brief Empties `list`, re-placing each event relative to the (already
+ * advanced) cursor.  Events that are now due are chained onto `due` unsorted.
+ */
+static void redistribute(mu_sched_wheel_t *wheel, mu_event_t **list,
+                         mu_event_t **due) {
+    mu_event_t *evt = *list;
+    *list = NULL;
+    while (evt) {
+        mu_event_t *next = evt->next;
+        uint64_t tick = event_tick_of(wheel, evt);
+        if (tick <= wheel->cursor) {
+            evt->next = *due;
+            *due = evt;
+        } else {
+            place(wheel, evt, tick);
+        }
+        evt = next;
+    }
+}
+
+static void take_slots(mu_sched_wheel_t *wheel, unsigned level, uint64_t mask,
+                       mu_event_t **due) {
+    uint64_t bits = wheel->occupied[level] & mask;
+    wheel->occupied[level] &= ~bits;
+    while (bits) {
+        unsigned slot = lsb64(bits);
+        bits &= bits - 1;
+        redistribute(wheel, &wheel->slots[level][slot], due);
+    }
+}
+
+static mu_event_t *list_earliest(mu_event_t *list) {
+    mu_event_t *earliest = list;
+    for (mu_event_t *evt = list; evt != NULL; evt = evt->next) {
+        if (mu_event_is_before(evt, earliest)) {
+            earliest = evt;
+        }
+    }
+    return earliest;
+}
+
+static void take_matching(mu_event_t **head, mu_thunk_t *thunk,
+                          mu_event_t **removed) {
+    mu_event_t *evt = *head;
+    while (evt) {
+        mu_event_t *next = evt->next;
+        if (evt->thunk == thunk) {
+            list_unlink(evt);
+            evt->next = *removed;
+            *removed = evt;
+        }
+        evt = next;
+    }
+}
+
+static void visit_list(const mu_event_t *list, mu_event_visit_fn fn,
+                       void *ctx) {
+    for (const mu_event_t *evt = list; evt != NULL; evt = evt->next) {
+        fn(evt, ctx);
+    }
+}
@@ -0,0 +1,288 @@
+// mu_sched/test/bench_mu_sched.c
+//
+// Microbenchmarks for the scheduler's hot paths.  Build and run with
+// `make bench`.  Prints one CSV row per case:
+//
+//     op,store,depth,pattern,ns_per_op
+//
+// `store` is the event store (pvec, wheel, heap, or heap_keyed for a heap
+// with a parallel key array), `depth` the number of
+// events already pending, and `pattern` how their timestamps are chosen:
+// "random" spreads them over the next ~17 minutes, "near" puts them all
+// within the next millisecond.  The scheduler runs on a frozen virtual clock
+// so that only its own work is timed.
+
+#include "mu_pool.h"
+#include "mu_pqueue.h"
+#include "mu_pvec.h"
+#include "mu_sched.h"
+#include "mu_sched_heap.h"
+#include "mu_sched_wheel.h"
+#include "mu_spsc.h"
+#include "mu_thunk.h"
+#include "mu_time.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+// backing-store sizes
+#define MAX_BENCH_DEPTH 4096
+#define BENCH_BATCH 64
+#define MAX_BENCH_EVENTS (MAX_BENCH_DEPTH + BENCH_BATCH)
+#define MAX_BENCH_ISR 1024
+
+// repetitions per case
+#define BENCH_ROUNDS 200
+
+//-----------------------------------------------------------------------------
+// Scheduler under test
+
+typedef enum {
+    STORE_PVEC,
+    STORE_WHEEL,
+    STORE_HEAP,
+    STORE_HEAP_KEYED
+} bench_store_t;
+
+static const char *const s_store_names[] = {"pvec", "wheel", "heap",
+                                            "heap_keyed"};
+
+static mu_sched_t s_sched;
+static mu_spsc_t s_isr_q;
+static mu_pqueue_t s_asap_q;
+static mu_pvec_t s_event_q;
+static mu_sched_wheel_t s_wheel;
+static mu_sched_heap_t s_heap;
+static mu_pool_t s_pool;
+
+static mu_spsc_item_t s_isr_store[MAX_BENCH_ISR];
+static void *s_asap_store[MAX_BENCH_EVENTS];
+static void *s_event_store[MAX_BENCH_EVENTS];
+static mu_event_t *s_heap_store[MAX_BENCH_EVENTS];
+static mu_sched_heap_key_t s_key_store[MAX_BENCH_EVENTS];
+static mu_event_t s_pool_store[MAX_BENCH_EVENTS];
+
+static mu_time_abs_t frozen_time(void) { return (mu_time_abs_t){0}; }
+
+static void init_bench_scheduler(bench_store_t store) {
+    mu_spsc_init(&s_isr_q, s_isr_store, MAX_BENCH_ISR);
+    mu_pqueue_init(&s_asap_q, s_asap_store, MAX_BENCH_EVENTS);
+    mu_pool_init(&s_pool, s_pool_store, MAX_BENCH_EVENTS, sizeof(mu_event_t));
+    switch (store) {
+    case STORE_PVEC:
+        mu_pvec_init(&s_event_q, s_event_store, MAX_BENCH_EVENTS);
+        mu_sched_init_ex(&s_sched, &s_isr_q, &s_asap_q, &s_event_q, &s_pool);
+        break;
+    case STORE_WHEEL:
+        mu_sched_wheel_init(&s_wheel, 1000);
+        mu_sched_init_wheel_ex(&s_sched, &s_isr_q, &s_asap_q, &s_wheel,
+                               &s_pool);
+        break;
+    case STORE_HEAP:
+        mu_sched_heap_init(&s_heap, s_heap_store, MAX_BENCH_EVENTS);
+        mu_sched_init_heap_ex(&s_sched, &s_isr_q, &s_asap_q, &s_heap,
+                              &s_pool);
+        break;
+    case STORE_HEAP_KEYED:
+        mu_sched_heap_init_keyed(&s_heap, s_heap_store, s_key_store,
+                                 MAX_BENCH_EVENTS);
+        mu_sched_init_heap_ex(&s_sched, &s_isr_q, &s_asap_q, &s_heap,
+                              &s_pool);
+        break;
+    }
+    mu_sched_set_time_fn_ex(&s_sched, frozen_time);
+}
+
+//-----------------------------------------------------------------------------
+// Helpers
+
+static void noop_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+}
+
+static mu_thunk_t s_filler;   // owns the pre-filled events
+static mu_thunk_t s_measured; // owns the events added by a benchmark
+
+static uint32_t s_rng = 2463534242u;
+
+static uint32_t xorshift32(void) {
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng;
+}
+
+static mu_time_abs_t pick_time(bool near) {
+    uint64_t ns = near ? 1 + xorshift32() % 1000000u
+                       : 1000000000ull + (uint64_t)xorshift32() * 256u;
+    return mu_time_offset((mu_time_abs_t){0}, (mu_time_rel_t)ns);
+}
+
+static uint64_t clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void report(const char *op, const char *store, size_t depth,
+                   const char *pattern, uint64_t elapsed_ns, size_t ops) {
+    printf("%s,%s,%zu,%s,%.1f\n", op, store, depth, pattern,
+           (double)elapsed_ns / (double)ops);
+}
+
+static void prefill(bench_store_t store, size_t depth, bool near) {
+    init_bench_scheduler(store);
+    for (size_t i = 0; i < depth; i++) {
+        mu_sched_at_ex(&s_sched, &s_filler, pick_time(near));
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks
+
+static void bench_at(bench_store_t store, size_t depth, bool near) {
+    uint64_t elapsed = 0;
+
+    prefill(store, depth, near);
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        mu_time_abs_t times[BENCH_BATCH];
+        for (int i = 0; i < BENCH_BATCH; i++) {
+            times[i] = pick_time(near);
+        }
+        uint64_t start = clock_ns();
+        for (int i = 0; i < BENCH_BATCH; i++) {
+            mu_sched_at_ex(&s_sched, &s_measured, times[i]);
+        }
+        elapsed += clock_ns() - start;
+        mu_sched_delete_thunk_events_ex(&s_sched, &s_measured);
+    }
+    report("at", s_store_names[store], depth, near ? "near" : "random",
+           elapsed, (size_t)BENCH_ROUNDS * BENCH_BATCH);
+}
+
+static void bench_delete(bench_store_t store, size_t depth, bool near) {
+    uint64_t elapsed = 0;
+
+    prefill(store, depth, near);
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        mu_sched_at_ex(&s_sched, &s_measured, pick_time(near));
+        uint64_t start = clock_ns();
+        mu_sched_delete_thunk_events_ex(&s_sched, &s_measured);
+        elapsed += clock_ns() - start;
+    }
+    report("delete_thunk_events", s_store_names[store], depth,
+           near ? "near" : "random", elapsed, BENCH_ROUNDS);
+}
+
+static void bench_now(void) {
+    uint64_t elapsed = 0;
+
+    init_bench_scheduler(STORE_PVEC);
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        uint64_t start = clock_ns();
+        for (int i = 0; i < BENCH_BATCH; i++) {
+            mu_sched_now_ex(&s_sched, &s_measured);
+        }
+        elapsed += clock_ns() - start;
+        mu_sched_step_n_ex(&s_sched, BENCH_BATCH);
+    }
+    report("now", "-", 0, "-", elapsed, (size_t)BENCH_ROUNDS * BENCH_BATCH);
+}
+
+static void bench_from_isr(void) {
+    uint64_t elapsed = 0;
+
+    init_bench_scheduler(STORE_PVEC);
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        uint64_t start = clock_ns();
+        for (int i = 0; i < BENCH_BATCH; i++) {
+            mu_sched_from_isr_ex(&s_sched, &s_measured);
+        }
+        elapsed += clock_ns() - start;
+        mu_sched_step_n_ex(&s_sched, BENCH_BATCH);
+    }
+    report("from_isr", "-", 0, "-", elapsed,
+           (size_t)BENCH_ROUNDS * BENCH_BATCH);
+}
+
+static void bench_step_empty(bench_store_t store, size_t depth) {
+    uint64_t elapsed = 0;
+
+    // Pending events, none due: each step only checks the store's head
+    prefill(store, depth, false);
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        uint64_t start = clock_ns();
+        for (int i = 0; i < BENCH_BATCH; i++) {
+            mu_sched_step_ex(&s_sched);
+        }
+        elapsed += clock_ns() - start;
+    }
+    report("step_empty", s_store_names[store], depth, "random", elapsed,
+           (size_t)BENCH_ROUNDS * BENCH_BATCH);
+}
+
+static void bench_step_loaded(bench_store_t store, size_t depth) {
+    uint64_t elapsed = 0;
+
+    // One ready thunk per step, behind `depth` pending events
+    prefill(store, depth, false);
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < BENCH_BATCH; i++) {
+            mu_sched_now_ex(&s_sched, &s_measured);
+        }
+        uint64_t start = clock_ns();
+        for (int i = 0; i < BENCH_BATCH; i++) {
+            mu_sched_step_ex(&s_sched);
+        }
+        elapsed += clock_ns() - start;
+    }
+    report("step_loaded", s_store_names[store], depth, "random", elapsed,
+           (size_t)BENCH_ROUNDS * BENCH_BATCH);
+}
+
+static void bench_step_due(bench_store_t store, size_t depth) {
+    uint64_t elapsed = 0;
+
+    // A burst of `depth` due events, promoted and run one step at a time
+    init_bench_scheduler(store);
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (size_t i = 0; i < depth; i++) {
+            mu_sched_at_ex(&s_sched, &s_measured, (mu_time_abs_t){0});
+        }
+        uint64_t start = clock_ns();
+        for (size_t i = 0; i < depth; i++) {
+            mu_sched_step_ex(&s_sched);
+        }
+        elapsed += clock_ns() - start;
+    }
+    report("step_due", s_store_names[store], depth, "-", elapsed,
+           (size_t)BENCH_ROUNDS * depth);
+}
+
+//-----------------------------------------------------------------------------
+// Driver
+
+int main(void) {
+    static const size_t depths[] = {16, 256, MAX_BENCH_DEPTH};
+    const size_t n_depths = sizeof(depths) / sizeof(depths[0]);
+
+    mu_thunk_init(&s_filler, noop_fn);
+    mu_thunk_init(&s_measured, noop_fn);
+
+    printf("op,store,depth,pattern,ns_per_op\n");
+    bench_now();
+    bench_from_isr();
+    for (int store = STORE_PVEC; store <= STORE_HEAP_KEYED; store++) {
+        for (size_t d = 0; d < n_depths; d++) {
+            bench_at((bench_store_t)store, depths[d], false);
+            bench_at((bench_store_t)store, depths[d], true);
+            bench_delete((bench_store_t)store, depths[d], false);
+            bench_step_empty((bench_store_t)store, depths[d]);
+            bench_step_loaded((bench_store_t)store, depths[d]);
+        }
+        bench_step_due((bench_store_t)store, 256);
+    }
+    return 0;
+}
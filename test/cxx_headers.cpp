@@ -0,0 +1,17 @@
+// mu_sched/test/cxx_headers.cpp
+//
+// Compiled (never run) by `make tests` to check that the public headers
+// meant for mixed C / C++ projects still parse as C++.
+
+#include "mu_event.h"
+#include "mu_sched.h"
+#include "mu_sched_coro.h"
+#include "mu_sched_edf.h"
+#include "mu_sched_exec.h"
+#include "mu_sched_heap.h"
+#include "mu_sched_mpsc.h"
+#include "mu_sched_signal.h"
+#include "mu_sched_static.h"
+#include "mu_sched_stats.h"
+#include "mu_sched_trace.h"
+#include "mu_sched_wheel.h"
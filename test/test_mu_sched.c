@@ -5,14 +5,28 @@
 #include "mu_pvec.h"
 #include "mu_queue.h"
 #include "mu_sched.h"
+#include "mu_sched_coro.h"
+#include "mu_sched_edf.h"
+#include "mu_sched_exec.h"
+#include "mu_sched_mpsc.h"
+#include "mu_sched_signal.h"
+#include "mu_sched_static.h"
+#include "mu_sched_trace.h"
+#include "mu_sched_wheel.h"
 #include "mu_spsc.h"
 #include "mu_thunk.h"
 #include "mu_time.h"
 #include "unity.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
 #include <stddef.h>
+#include <string.h>
 
 // backing-store sizes
 #define MAX_TEST_THUNKS 4
+#define MAX_WHEEL_TEST_EVENTS 16
+#define MAX_REMOTE_TEST_THUNKS 8
 
 //-----------------------------------------------------------------------------
 // Virtual‐time support
@@ -24,8 +38,29 @@ static mu_time_abs_t get_virtual_time(void) { return virtual_time; }
 
 static void set_virtual_time(mu_time_abs_t t) { virtual_time = t; }
 
-static mu_time_abs_t mk_time(int s, long ns) {
-    return (mu_time_abs_t){.seconds = s, .nanoseconds = ns};
+// Like get_virtual_time(), but counts how often the scheduler reads the clock.
+static int clock_reads;
+
+static mu_time_abs_t get_counted_virtual_time(void) {
+    clock_reads++;
+    return virtual_time;
+}
+
+// With MU_SCHED_TICK_EVENTS the scheduler only resolves whole ticks, so the
+// tests count virtual time in units of one tick: mk_time() and TU() scale by
+// TEST_NS.  Without it a unit is one nanosecond and nothing is scaled.
+#ifdef MU_SCHED_TICK_EVENTS
+#define TEST_NS MU_SCHED_TICK_NS
+#else
+#define TEST_NS 1
+#endif
+
+/** A relative time of `n` test units, in nanoseconds. */
+#define TU(n) ((mu_time_rel_t)(n) * TEST_NS)
+
+static mu_time_abs_t mk_time(int s, long units) {
+    return mu_time_offset((mu_time_abs_t){.seconds = s, .nanoseconds = 0},
+                          TU(units));
 }
 
 //-----------------------------------------------------------------------------
@@ -48,6 +83,31 @@ static void counting_thunk_init(counting_thunk_t *counting_thunk) {
     mu_thunk_init(&counting_thunk->thunk, counting_thunk_fn);
 }
 
+//-----------------------------------------------------------------------------
+// order_thunk_t: a thunk that appends its id to a log when called.
+//-----------------------------------------------------------------------------
+
+typedef struct {
+    mu_thunk_t thunk;
+    int id;
+} order_thunk_t;
+
+static int order_log[MAX_WHEEL_TEST_EVENTS];
+static int order_log_count;
+
+static void order_thunk_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    order_thunk_t *order_thunk = (order_thunk_t *)thunk;
+    if (order_log_count < MAX_WHEEL_TEST_EVENTS) {
+        order_log[order_log_count++] = order_thunk->id;
+    }
+}
+
+static void order_thunk_init(order_thunk_t *order_thunk, int id) {
+    order_thunk->id = id;
+    mu_thunk_init(&order_thunk->thunk, order_thunk_fn);
+}
+
 // A thunk whose job is simply to check that
 // mu_sched_current_thunk() == the thunk pointer we were given.
 static void current_thunk_fn(mu_thunk_t *thunk, void *args) {
@@ -96,6 +156,106 @@ static void init_scheduler_for_test(void) {
     set_virtual_time(mk_time(0, 0));
 }
 
+/*
+ * Same as init_scheduler_for_test(), but holds pending events in a timer
+ * wheel with the given resolution (in test units) instead of a sorted pvec.
+ */
+static void init_wheel_scheduler_for_test(uint32_t units_per_tick) {
+    static mu_event_t pool_store[MAX_WHEEL_TEST_EVENTS];
+    static void *asap_store[MAX_WHEEL_TEST_EVENTS];
+    static mu_spsc_item_t isr_store[MAX_TEST_THUNKS];
+
+    static mu_spsc_t isr_q;
+    static mu_pqueue_t asap_q;
+    static mu_sched_wheel_t wheel;
+    static mu_pool_t pool;
+
+#if defined(MU_SCHED_TICK_EVENTS) && MU_SCHED_TICK_BITS < 64
+    TEST_IGNORE_MESSAGE("the timer wheel needs 64-bit ticks");
+#endif
+    TEST_ASSERT_EQUAL(MU_SPSC_ERR_NONE,
+                      mu_spsc_init(&isr_q, isr_store, MAX_TEST_THUNKS));
+    TEST_ASSERT_NOT_NULL(
+        mu_pqueue_init(&asap_q, asap_store, MAX_WHEEL_TEST_EVENTS));
+    TEST_ASSERT_NOT_NULL(
+        mu_sched_wheel_init(&wheel, (uint32_t)TU(units_per_tick)));
+    TEST_ASSERT_NOT_NULL(mu_pool_init(&pool, pool_store, MAX_WHEEL_TEST_EVENTS,
+                                      sizeof(mu_event_t)));
+
+    TEST_ASSERT_TRUE(mu_sched_init_wheel(&isr_q, &asap_q, &wheel, &pool));
+    mu_sched_set_time_fn(get_virtual_time);
+    set_virtual_time(mk_time(0, 0));
+    order_log_count = 0;
+}
+
+/*
+ * Same as init_scheduler_for_test(), but holds pending events in a 4-ary
+ * heap instead of a sorted pvec; if `keyed`, one that keeps event keys in a
+ * parallel array.
+ */
+static void init_heap_scheduler_with_keys(bool keyed) {
+    static mu_event_t pool_store[MAX_WHEEL_TEST_EVENTS];
+    static mu_event_t *heap_store[MAX_WHEEL_TEST_EVENTS];
+    static mu_sched_heap_key_t key_store[MAX_WHEEL_TEST_EVENTS];
+    static void *asap_store[MAX_WHEEL_TEST_EVENTS];
+    static mu_spsc_item_t isr_store[MAX_TEST_THUNKS];
+
+    static mu_spsc_t isr_q;
+    static mu_pqueue_t asap_q;
+    static mu_sched_heap_t heap;
+    static mu_pool_t pool;
+
+    TEST_ASSERT_EQUAL(MU_SPSC_ERR_NONE,
+                      mu_spsc_init(&isr_q, isr_store, MAX_TEST_THUNKS));
+    TEST_ASSERT_NOT_NULL(
+        mu_pqueue_init(&asap_q, asap_store, MAX_WHEEL_TEST_EVENTS));
+    TEST_ASSERT_NOT_NULL(mu_sched_heap_init_keyed(
+        &heap, heap_store, keyed ? key_store : NULL, MAX_WHEEL_TEST_EVENTS));
+    TEST_ASSERT_NOT_NULL(mu_pool_init(&pool, pool_store, MAX_WHEEL_TEST_EVENTS,
+                                      sizeof(mu_event_t)));
+
+    TEST_ASSERT_TRUE(mu_sched_init_heap(&isr_q, &asap_q, &heap, &pool));
+    mu_sched_set_time_fn(get_virtual_time);
+    set_virtual_time(mk_time(0, 0));
+    order_log_count = 0;
+}
+
+static void init_heap_scheduler_for_test(void) {
+    init_heap_scheduler_with_keys(false);
+}
+
+/*
+ * Build & initialize a caller-allocated scheduler instance on the given
+ * backing stores, using the virtual clock.
+ */
+typedef struct {
+    mu_sched_t sched;
+    mu_event_t pool_store[MAX_TEST_THUNKS];
+    void *event_store[MAX_TEST_THUNKS];
+    void *asap_store[MAX_TEST_THUNKS];
+    mu_spsc_item_t isr_store[MAX_TEST_THUNKS];
+    mu_spsc_t isr_q;
+    mu_pqueue_t asap_q;
+    mu_pvec_t event_q;
+    mu_pool_t pool;
+} test_instance_t;
+
+static void init_instance_for_test(test_instance_t *inst) {
+    TEST_ASSERT_EQUAL(MU_SPSC_ERR_NONE, mu_spsc_init(&inst->isr_q,
+                                                     inst->isr_store,
+                                                     MAX_TEST_THUNKS));
+    TEST_ASSERT_NOT_NULL(
+        mu_pqueue_init(&inst->asap_q, inst->asap_store, MAX_TEST_THUNKS));
+    TEST_ASSERT_NOT_NULL(
+        mu_pvec_init(&inst->event_q, inst->event_store, MAX_TEST_THUNKS));
+    TEST_ASSERT_NOT_NULL(mu_pool_init(&inst->pool, inst->pool_store,
+                                      MAX_TEST_THUNKS, sizeof(mu_event_t)));
+    TEST_ASSERT_TRUE(mu_sched_init_ex(&inst->sched, &inst->isr_q,
+                                      &inst->asap_q, &inst->event_q,
+                                      &inst->pool));
+    mu_sched_set_time_fn_ex(&inst->sched, get_virtual_time);
+}
+
 void setUp(void) {}
 void tearDown(void) {}
 
@@ -186,7 +346,7 @@ void test_mu_sched_in_respects_delay(void) {
     counting_thunk_init(&A);
 
     set_virtual_time(mk_time(100, 0));
-    TEST_ASSERT_TRUE(mu_sched_in(&A.thunk, 5)); // relative time...
+    TEST_ASSERT_TRUE(mu_sched_in(&A.thunk, TU(5))); // relative time...
 
     set_virtual_time(mk_time(100, 4));
     mu_sched_step();
@@ -353,7 +513,7 @@ void test_mu_sched_current_time_returns_overridden_time(void) {
     init_scheduler_for_test();
     // init_scheduler_for_test already did: mu_sched_set_time_fn(get_virtual_time)
     // and set_virtual_time(mk_time(0,0))
-    mu_time_abs_t t = mk_time(42, 123);
+    mu_time_abs_t t = {.seconds = 42, .nanoseconds = 123};
     set_virtual_time(t);
     mu_time_abs_t now = mu_sched_current_time();
     TEST_ASSERT_EQUAL_INT(42, now.seconds);
@@ -403,6 +563,2324 @@ void test_mu_sched_delete_thunk_events_removes_matching(void) {
     TEST_ASSERT_EQUAL_INT(1, B.call_count);
 }
 
+// -----------------------------------------------------------------------------
+// Tests for mu_sched_step_n()
+// -----------------------------------------------------------------------------
+
+void test_mu_sched_step_n_isr_first_and_budget(void) {
+    order_thunk_t A, B, C;
+
+    init_scheduler_for_test();
+    order_log_count = 0;
+    order_thunk_init(&A, 0);
+    order_thunk_init(&B, 1);
+    order_thunk_init(&C, 2);
+
+    TEST_ASSERT_TRUE(mu_sched_now(&A.thunk));
+    TEST_ASSERT_TRUE(mu_sched_now(&B.thunk));
+    TEST_ASSERT_TRUE(mu_sched_from_isr(&C.thunk));
+
+    TEST_ASSERT_EQUAL_size_t(2, mu_sched_step_n(2));
+    TEST_ASSERT_EQUAL_INT(2, order_log_count);
+    TEST_ASSERT_EQUAL_INT(2, order_log[0]); // ISR thunk first
+    TEST_ASSERT_EQUAL_INT(0, order_log[1]);
+
+    TEST_ASSERT_EQUAL_size_t(1, mu_sched_step_n(10));
+    TEST_ASSERT_EQUAL_INT(1, order_log[2]);
+    TEST_ASSERT_EQUAL_size_t(0, mu_sched_step_n(10));
+}
+
+void test_mu_sched_step_n_reads_clock_once(void) {
+    counting_thunk_t A, B, C;
+
+    init_scheduler_for_test();
+    mu_sched_set_time_fn(get_counted_virtual_time);
+    counting_thunk_init(&A);
+    counting_thunk_init(&B);
+    counting_thunk_init(&C);
+
+    TEST_ASSERT_TRUE(mu_sched_at(&A.thunk, mk_time(1, 0)));
+    TEST_ASSERT_TRUE(mu_sched_at(&B.thunk, mk_time(2, 0)));
+    TEST_ASSERT_TRUE(mu_sched_at(&C.thunk, mk_time(3, 0)));
+    TEST_ASSERT_TRUE(mu_sched_now(&A.thunk));
+
+    set_virtual_time(mk_time(5, 0));
+    clock_reads = 0;
+    TEST_ASSERT_EQUAL_size_t(4, mu_sched_step_n(10));
+#ifdef MU_SCHED_STATS
+    // Statistics time the end of every thunk run as well
+    TEST_ASSERT_EQUAL_INT(1 + 4, clock_reads);
+#else
+    TEST_ASSERT_EQUAL_INT(1, clock_reads);
+#endif
+    TEST_ASSERT_EQUAL_INT(2, A.call_count);
+    TEST_ASSERT_EQUAL_INT(1, B.call_count);
+    TEST_ASSERT_EQUAL_INT(1, C.call_count);
+}
+
+void test_mu_sched_step_n_idle_only_when_nothing_ran(void) {
+    counting_thunk_t A, idle;
+
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+    counting_thunk_init(&idle);
+    mu_sched_set_idle_thunk(&idle.thunk);
+
+    TEST_ASSERT_TRUE(mu_sched_now(&A.thunk));
+    TEST_ASSERT_EQUAL_size_t(1, mu_sched_step_n(4));
+    TEST_ASSERT_EQUAL_INT(0, idle.call_count);
+
+    TEST_ASSERT_EQUAL_size_t(0, mu_sched_step_n(4));
+    TEST_ASSERT_EQUAL_INT(1, idle.call_count);
+}
+
+// -----------------------------------------------------------------------------
+// Tests for mu_sched_next_deadline() and mu_sched_idle_timeout()
+// -----------------------------------------------------------------------------
+
+void test_mu_sched_next_deadline_reports_earliest(void) {
+    counting_thunk_t A, B;
+    mu_sched_handle_t handle;
+    mu_time_abs_t deadline;
+
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+    counting_thunk_init(&B);
+
+    TEST_ASSERT_FALSE(mu_sched_next_deadline(&deadline));
+
+    TEST_ASSERT_TRUE(mu_sched_at(&A.thunk, mk_time(9, 0)));
+    TEST_ASSERT_TRUE(mu_sched_at_handle(&B.thunk, mk_time(3, 0), &handle));
+    TEST_ASSERT_TRUE(mu_sched_next_deadline(&deadline));
+    TEST_ASSERT_EQUAL_INT(3, deadline.seconds);
+
+    // A cancelled (tombstoned) event is not a deadline
+    TEST_ASSERT_TRUE(mu_sched_cancel(&handle));
+    TEST_ASSERT_TRUE(mu_sched_next_deadline(&deadline));
+    TEST_ASSERT_EQUAL_INT(9, deadline.seconds);
+}
+
+void test_mu_sched_wheel_next_deadline_reports_earliest(void) {
+    counting_thunk_t A;
+    mu_time_abs_t deadline;
+
+    init_wheel_scheduler_for_test(1);
+    counting_thunk_init(&A);
+
+    TEST_ASSERT_FALSE(mu_sched_next_deadline(&deadline));
+    TEST_ASSERT_TRUE(mu_sched_at(&A.thunk, mk_time(100, 0)));
+    TEST_ASSERT_TRUE(mu_sched_at(&A.thunk, mk_time(0, 700)));
+    TEST_ASSERT_TRUE(mu_sched_at(&A.thunk, mk_time(0, 650)));
+    TEST_ASSERT_TRUE(mu_sched_at(&A.thunk, mk_time(0, 90000)));
+
+    TEST_ASSERT_TRUE(mu_sched_next_deadline(&deadline));
+    TEST_ASSERT_EQUAL_INT(0, deadline.seconds);
+    TEST_ASSERT_EQUAL_INT64(TU(650), deadline.nanoseconds);
+
+    // After the cursor moves, the remaining events live on other levels.
+    set_virtual_time(mk_time(0, 800));
+    mu_sched_step();
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(2, A.call_count);
+    TEST_ASSERT_TRUE(mu_sched_next_deadline(&deadline));
+    TEST_ASSERT_EQUAL_INT64(TU(90000), deadline.nanoseconds);
+}
+
+void test_mu_sched_idle_timeout(void) {
+    counting_thunk_t A;
+    mu_time_rel_t timeout;
+
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+
+    // Nothing pending: sleep until an interrupt
+    TEST_ASSERT_FALSE(mu_sched_idle_timeout(&timeout));
+
+    set_virtual_time(mk_time(10, 0));
+    TEST_ASSERT_TRUE(mu_sched_in(&A.thunk, TU(250)));
+    TEST_ASSERT_TRUE(mu_sched_idle_timeout(&timeout));
+    TEST_ASSERT_EQUAL_INT64(TU(250), timeout);
+
+    // Overdue events don't produce negative timeouts
+    set_virtual_time(mk_time(11, 0));
+    TEST_ASSERT_TRUE(mu_sched_idle_timeout(&timeout));
+    TEST_ASSERT_EQUAL_INT64(0, timeout);
+
+    // Runnable thunks mean don't sleep at all
+    mu_sched_delete_thunk_events(&A.thunk);
+    TEST_ASSERT_TRUE(mu_sched_now(&A.thunk));
+    TEST_ASSERT_TRUE(mu_sched_idle_timeout(&timeout));
+    TEST_ASSERT_EQUAL_INT64(0, timeout);
+}
+
+// -----------------------------------------------------------------------------
+// Tests for mu_sched_cancel()
+// -----------------------------------------------------------------------------
+
+void test_mu_sched_cancel_pending_event(void) {
+    counting_thunk_t A, B;
+    mu_sched_handle_t handle;
+
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+    counting_thunk_init(&B);
+
+    TEST_ASSERT_TRUE(mu_sched_at_handle(&A.thunk, mk_time(0, 5), &handle));
+    TEST_ASSERT_TRUE(mu_sched_in(&B.thunk, 5));
+    TEST_ASSERT_TRUE(mu_sched_cancel(&handle));
+    TEST_ASSERT_NULL(handle.event);
+    TEST_ASSERT_FALSE(mu_sched_cancel(&handle));
+
+    set_virtual_time(mk_time(0, 10));
+    mu_sched_step();
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(0, A.call_count);
+    TEST_ASSERT_EQUAL_INT(1, B.call_count);
+}
+
+void test_mu_sched_cancel_after_run_returns_false(void) {
+    counting_thunk_t A;
+    mu_sched_handle_t handle;
+
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+
+    TEST_ASSERT_TRUE(mu_sched_in_handle(&A.thunk, 0, &handle));
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(1, A.call_count);
+    TEST_ASSERT_FALSE(mu_sched_cancel(&handle));
+}
+
+void test_mu_sched_cancel_stale_handle_is_ignored(void) {
+    counting_thunk_t A, B;
+    mu_sched_handle_t stale, fresh;
+
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+    counting_thunk_init(&B);
+
+    TEST_ASSERT_TRUE(mu_sched_at_handle(&A.thunk, mk_time(0, 0), &stale));
+    mu_sched_step();
+    // B's event is very likely to recycle A's mu_event_t
+    TEST_ASSERT_TRUE(mu_sched_at_handle(&B.thunk, mk_time(0, 0), &fresh));
+    TEST_ASSERT_FALSE(mu_sched_cancel(&stale));
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(1, B.call_count);
+}
+
+void test_mu_sched_wheel_cancel_frees_immediately(void) {
+    counting_thunk_t A;
+    mu_sched_handle_t handle;
+
+    init_wheel_scheduler_for_test(1);
+    counting_thunk_init(&A);
+
+    // Far more schedule/cancel cycles than the pool holds, without stepping.
+    for (int i = 0; i < 4 * MAX_WHEEL_TEST_EVENTS; i++) {
+        TEST_ASSERT_TRUE(mu_sched_in_handle(&A.thunk, TU(1000 + i), &handle));
+        TEST_ASSERT_TRUE(mu_sched_cancel(&handle));
+    }
+    set_virtual_time(mk_time(10, 0));
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(0, A.call_count);
+}
+
+// -----------------------------------------------------------------------------
+// Tests for mu_sched_every()
+// -----------------------------------------------------------------------------
+
+static void check_every_keeps_phase_and_skips_missed(void) {
+    counting_thunk_t A, B;
+    mu_sched_handle_t handle;
+    mu_time_abs_t deadline;
+
+    counting_thunk_init(&A);
+    counting_thunk_init(&B);
+    TEST_ASSERT_FALSE(mu_sched_every(&A.thunk, 0));
+    TEST_ASSERT_TRUE(mu_sched_every_handle(&A.thunk, TU(10), &handle));
+
+    // Run late: the next deadline still follows the first one, not `now`
+    set_virtual_time(mk_time(0, 13));
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(1, A.call_count);
+    TEST_ASSERT_TRUE(mu_sched_next_deadline(&deadline));
+    TEST_ASSERT_EQUAL_INT(TU(20), deadline.nanoseconds);
+
+    // The periodic event needs only one wrapper: the rest of the pool is free
+    for (int i = 0; i < MAX_TEST_THUNKS - 1; i++) {
+        TEST_ASSERT_TRUE(mu_sched_at(&B.thunk, mk_time(1, 0)));
+    }
+    mu_sched_delete_thunk_events(&B.thunk);
+
+    set_virtual_time(mk_time(0, 20));
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(2, A.call_count);
+
+    // Far behind: one run, then back in phase
+    set_virtual_time(mk_time(0, 75));
+    mu_sched_step();
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(3, A.call_count);
+    TEST_ASSERT_TRUE(mu_sched_next_deadline(&deadline));
+    TEST_ASSERT_EQUAL_INT(TU(80), deadline.nanoseconds);
+
+    TEST_ASSERT_TRUE(mu_sched_cancel(&handle));
+    set_virtual_time(mk_time(1, 0));
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(3, A.call_count);
+    TEST_ASSERT_FALSE(mu_sched_next_deadline(&deadline));
+}
+
+void test_mu_sched_every_keeps_phase_and_skips_missed(void) {
+    init_scheduler_for_test();
+    check_every_keeps_phase_and_skips_missed();
+}
+
+void test_mu_sched_wheel_every_keeps_phase_and_skips_missed(void) {
+    init_wheel_scheduler_for_test(4);
+    check_every_keeps_phase_and_skips_missed();
+}
+
+// -----------------------------------------------------------------------------
+// Tests for caller-owned (intrusive) event nodes
+// -----------------------------------------------------------------------------
+
+// A task that embeds its own timer node, as on parts with no event pool.
+typedef struct {
+    counting_thunk_t counter;
+    mu_event_t timer;
+} timed_task_t;
+
+static void check_intrusive_events(mu_sched_t *sched) {
+    timed_task_t A, B;
+
+    counting_thunk_init(&A.counter);
+    counting_thunk_init(&B.counter);
+    mu_event_init(&A.timer);
+    mu_event_init(&B.timer);
+
+    // No pool: only caller-owned nodes can be scheduled
+    TEST_ASSERT_FALSE(mu_sched_at_ex(sched, &A.counter.thunk, mk_time(0, 1)));
+    TEST_ASSERT_FALSE(mu_sched_cancel_event_ex(sched, &A.timer));
+
+    TEST_ASSERT_TRUE(mu_sched_at_event_ex(sched, &A.timer, &A.counter.thunk,
+                                          mk_time(0, 10)));
+    TEST_ASSERT_TRUE(mu_sched_at_event_ex(sched, &B.timer, &B.counter.thunk,
+                                          mk_time(0, 20)));
+    // Re-arm A later than B
+    TEST_ASSERT_TRUE(mu_sched_at_event_ex(sched, &A.timer, &A.counter.thunk,
+                                          mk_time(0, 30)));
+
+    set_virtual_time(mk_time(0, 25));
+    mu_sched_step_ex(sched);
+    TEST_ASSERT_EQUAL_INT(0, A.counter.call_count);
+    TEST_ASSERT_EQUAL_INT(1, B.counter.call_count);
+
+    // B's node is free again once it has fired
+    TEST_ASSERT_FALSE(mu_sched_cancel_event_ex(sched, &B.timer));
+    TEST_ASSERT_TRUE(mu_sched_in_event_ex(sched, &B.timer, &B.counter.thunk,
+                                          TU(100)));
+
+    TEST_ASSERT_TRUE(mu_sched_cancel_event_ex(sched, &A.timer));
+    TEST_ASSERT_FALSE(mu_sched_cancel_event_ex(sched, &A.timer));
+    set_virtual_time(mk_time(1, 0));
+    mu_sched_step_ex(sched);
+    mu_sched_step_ex(sched);
+    TEST_ASSERT_EQUAL_INT(0, A.counter.call_count);
+    TEST_ASSERT_EQUAL_INT(2, B.counter.call_count);
+}
+
+void test_mu_sched_intrusive_events_without_pool(void) {
+    static test_instance_t inst;
+
+    init_instance_for_test(&inst);
+    TEST_ASSERT_TRUE(mu_sched_init_ex(&inst.sched, &inst.isr_q, &inst.asap_q,
+                                      &inst.event_q, NULL));
+    mu_sched_set_time_fn_ex(&inst.sched, get_virtual_time);
+    set_virtual_time(mk_time(0, 0));
+    check_intrusive_events(&inst.sched);
+}
+
+void test_mu_sched_wheel_intrusive_events_without_pool(void) {
+    static test_instance_t inst;
+    static mu_sched_wheel_t wheel;
+
+#if defined(MU_SCHED_TICK_EVENTS) && MU_SCHED_TICK_BITS < 64
+    TEST_IGNORE_MESSAGE("the timer wheel needs 64-bit ticks");
+#endif
+    init_instance_for_test(&inst);
+    TEST_ASSERT_NOT_NULL(mu_sched_wheel_init(&wheel, (uint32_t)TU(4)));
+    TEST_ASSERT_TRUE(mu_sched_init_wheel_ex(&inst.sched, &inst.isr_q,
+                                            &inst.asap_q, &wheel, NULL));
+    mu_sched_set_time_fn_ex(&inst.sched, get_virtual_time);
+    set_virtual_time(mk_time(0, 0));
+    check_intrusive_events(&inst.sched);
+}
+
+#ifdef MU_SCHED_STATS
+// -----------------------------------------------------------------------------
+// Tests for latency and runtime statistics
+// -----------------------------------------------------------------------------
+
+// A thunk that takes 1000 ns of virtual time to run.
+static void slow_thunk_fn(mu_thunk_t *thunk, void *args) {
+    counting_thunk_fn(thunk, args);
+    set_virtual_time(mu_time_offset(virtual_time, 1000));
+}
+
+void test_mu_sched_stats_lateness_and_runtime(void) {
+    counting_thunk_t A, B;
+    const mu_sched_thunk_stats_t *st;
+
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+    counting_thunk_init(&B);
+    mu_thunk_init(&B.thunk, slow_thunk_fn);
+    TEST_ASSERT_NULL(mu_sched_thunk_stats(&A.thunk));
+
+    // A is due at 100 ns but the scheduler only gets to it at 350 ns
+    TEST_ASSERT_TRUE(mu_sched_at(&A.thunk, mk_time(0, 100)));
+    set_virtual_time(mk_time(0, 350));
+    mu_sched_step();
+
+    st = mu_sched_thunk_stats(&A.thunk);
+    TEST_ASSERT_NOT_NULL(st);
+    TEST_ASSERT_EQUAL_UINT32(1, st->calls);
+    TEST_ASSERT_EQUAL_UINT32(1, st->timed_calls);
+    TEST_ASSERT_EQUAL_INT64(250, st->max_lateness);
+    TEST_ASSERT_EQUAL_INT64(0, st->max_runtime);
+    // 250 ns is in [128, 255]
+    TEST_ASSERT_EQUAL_UINT32(1, mu_sched_stats()->lag_histogram[8]);
+
+    // B is not timed, so only its runtime counts
+    TEST_ASSERT_TRUE(mu_sched_now(&B.thunk));
+    TEST_ASSERT_TRUE(mu_sched_now(&B.thunk));
+    mu_sched_step();
+    mu_sched_step();
+    st = mu_sched_thunk_stats(&B.thunk);
+    TEST_ASSERT_NOT_NULL(st);
+    TEST_ASSERT_EQUAL_UINT32(2, st->calls);
+    TEST_ASSERT_EQUAL_UINT32(0, st->timed_calls);
+    TEST_ASSERT_EQUAL_INT64(2000, st->total_runtime);
+    TEST_ASSERT_EQUAL_INT64(1000, st->max_runtime);
+
+    mu_sched_stats_reset();
+    TEST_ASSERT_NULL(mu_sched_thunk_stats(&A.thunk));
+    TEST_ASSERT_EQUAL_UINT32(0, mu_sched_stats()->lag_histogram[8]);
+}
+
+void test_mu_sched_stats_untracked_when_table_full(void) {
+    static counting_thunk_t thunks[MU_SCHED_STATS_THUNKS + 1];
+
+    init_scheduler_for_test();
+    for (int i = 0; i <= MU_SCHED_STATS_THUNKS; i++) {
+        counting_thunk_init(&thunks[i]);
+        TEST_ASSERT_TRUE(mu_sched_now(&thunks[i].thunk));
+        mu_sched_step();
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, mu_sched_stats()->untracked_calls);
+    TEST_ASSERT_NULL(
+        mu_sched_thunk_stats(&thunks[MU_SCHED_STATS_THUNKS].thunk));
+}
+#endif
+
+// -----------------------------------------------------------------------------
+// Tests for the trace ring
+// -----------------------------------------------------------------------------
+
+#define TRACE_TEST_RECORDS 16
+
+static mu_sched_trace_record_t trace_store[TRACE_TEST_RECORDS];
+static mu_sched_trace_t trace;
+static uint32_t trace_ticks;
+
+static uint32_t get_trace_ticks(void) { return trace_ticks++; }
+
+static void init_trace_for_test(void) {
+    trace_ticks = 0;
+    TEST_ASSERT_TRUE(mu_sched_trace_init(&trace, trace_store,
+                                         TRACE_TEST_RECORDS, get_trace_ticks,
+                                         1000));
+}
+
+typedef struct {
+    unsigned char bytes[sizeof(mu_sched_trace_header_t) +
+                        TRACE_TEST_RECORDS * sizeof(mu_sched_trace_record_t)];
+    size_t len;
+} trace_sink_t;
+
+static size_t trace_sink_write(void *ctx, const void *buf, size_t len) {
+    trace_sink_t *sink = (trace_sink_t *)ctx;
+    memcpy(&sink->bytes[sink->len], buf, len);
+    sink->len += len;
+    return len;
+}
+
+void test_mu_sched_trace_ring_wraps_and_writes_oldest_first(void) {
+    static trace_sink_t sink;
+    mu_sched_trace_header_t header;
+    mu_sched_trace_record_t rec;
+    int dummy;
+
+    TEST_ASSERT_FALSE(mu_sched_trace_init(&trace, trace_store, 3, NULL, 0));
+    init_trace_for_test();
+    TEST_ASSERT_EQUAL_size_t(0, mu_sched_trace_count(&trace));
+
+    for (int i = 0; i < TRACE_TEST_RECORDS + 2; i++) {
+        mu_sched_trace_put(&trace, MU_SCHED_TRACE_NOW, &dummy);
+    }
+    TEST_ASSERT_EQUAL_size_t(TRACE_TEST_RECORDS, mu_sched_trace_count(&trace));
+
+    sink.len = 0;
+    TEST_ASSERT_EQUAL_size_t(sizeof(sink.bytes),
+                             mu_sched_trace_write(&trace, trace_sink_write,
+                                                  &sink));
+    memcpy(&header, sink.bytes, sizeof(header));
+    TEST_ASSERT_EQUAL_HEX32(MU_SCHED_TRACE_MAGIC, header.magic);
+    TEST_ASSERT_EQUAL_UINT32(TRACE_TEST_RECORDS, header.count);
+    TEST_ASSERT_EQUAL_UINT32(1000, header.ticks_per_second);
+
+    // The two oldest records were overwritten
+    memcpy(&rec, &sink.bytes[sizeof(header)], sizeof(rec));
+    TEST_ASSERT_EQUAL_UINT32(2, rec.timestamp);
+    TEST_ASSERT_EQUAL_UINT32(2, rec.info >> 16);
+    TEST_ASSERT_EQUAL_UINT32(MU_SCHED_TRACE_CTX_SCHED, (rec.info >> 8) & 0xff);
+    TEST_ASSERT_EQUAL_UINT32(MU_SCHED_TRACE_NOW, rec.info & 0xff);
+    TEST_ASSERT_EQUAL_PTR(&dummy, (void *)rec.thunk);
+
+    mu_sched_trace_clear(&trace);
+    TEST_ASSERT_EQUAL_size_t(0, mu_sched_trace_count(&trace));
+}
+
+void test_mu_sched_trace_count_survives_head_wrap(void) {
+    static trace_sink_t sink;
+    mu_sched_trace_header_t header;
+    int dummy;
+
+    init_trace_for_test();
+    for (int i = 0; i < TRACE_TEST_RECORDS; i++) {
+        mu_sched_trace_put(&trace, MU_SCHED_TRACE_NOW, &dummy);
+    }
+    // Skip ahead to just short of 2^32 records, then wrap the head
+    trace.head = UINT32_MAX;
+    mu_sched_trace_put(&trace, MU_SCHED_TRACE_NOW, &dummy);
+    mu_sched_trace_put(&trace, MU_SCHED_TRACE_NOW, &dummy);
+    TEST_ASSERT_EQUAL_UINT32(1, trace.head);
+    TEST_ASSERT_EQUAL_size_t(TRACE_TEST_RECORDS, mu_sched_trace_count(&trace));
+
+    sink.len = 0;
+    mu_sched_trace_write(&trace, trace_sink_write, &sink);
+    memcpy(&header, sink.bytes, sizeof(header));
+    TEST_ASSERT_EQUAL_UINT32(TRACE_TEST_RECORDS, header.count);
+
+    mu_sched_trace_clear(&trace);
+    TEST_ASSERT_EQUAL_size_t(0, mu_sched_trace_count(&trace));
+}
+
+#ifdef MU_SCHED_TRACE
+void test_mu_sched_trace_records_scheduler_events(void) {
+    counting_thunk_t A, B, C, D;
+    mu_sched_handle_t handle;
+    const struct {
+        mu_sched_trace_type_t type;
+        mu_thunk_t *thunk;
+    } expected[] = {
+        {MU_SCHED_TRACE_AT, &A.thunk},
+        {MU_SCHED_TRACE_NOW, &B.thunk},
+        {MU_SCHED_TRACE_ISR, &C.thunk},
+        {MU_SCHED_TRACE_AT, &D.thunk},
+        {MU_SCHED_TRACE_CANCEL, &D.thunk},
+        {MU_SCHED_TRACE_RUN_START, &C.thunk},
+        {MU_SCHED_TRACE_RUN_END, &C.thunk},
+        {MU_SCHED_TRACE_PROMOTE, &A.thunk},
+        {MU_SCHED_TRACE_RUN_START, &B.thunk},
+        {MU_SCHED_TRACE_RUN_END, &B.thunk},
+    };
+
+    init_scheduler_for_test();
+    init_trace_for_test();
+    mu_sched_set_trace(&trace);
+    counting_thunk_init(&A);
+    counting_thunk_init(&B);
+    counting_thunk_init(&C);
+    counting_thunk_init(&D);
+
+    TEST_ASSERT_TRUE(mu_sched_at(&A.thunk, mk_time(0, 5)));
+    TEST_ASSERT_TRUE(mu_sched_now(&B.thunk));
+    TEST_ASSERT_TRUE(mu_sched_from_isr(&C.thunk));
+    TEST_ASSERT_TRUE(mu_sched_in_handle(&D.thunk, 10, &handle));
+    TEST_ASSERT_TRUE(mu_sched_cancel(&handle));
+
+    set_virtual_time(mk_time(0, 5));
+    mu_sched_step(); // runs C
+    mu_sched_step(); // promotes A, runs B
+
+    size_t n = sizeof(expected) / sizeof(expected[0]);
+    TEST_ASSERT_EQUAL_size_t(n, mu_sched_trace_count(&trace));
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT_EQUAL_UINT32(expected[i].type, trace_store[i].info & 0xff);
+        TEST_ASSERT_EQUAL_PTR(expected[i].thunk, (void *)trace_store[i].thunk);
+        TEST_ASSERT_EQUAL_UINT32(i, trace_store[i].timestamp);
+    }
+    // Only the ISR post was written from another context
+    for (size_t i = 0; i < n; i++) {
+        unsigned context = (trace_store[i].info >> 8) & 0xff;
+        TEST_ASSERT_EQUAL_UINT32(i == 2 ? MU_SCHED_TRACE_CTX_ISR
+                                        : MU_SCHED_TRACE_CTX_SCHED,
+                                 context);
+    }
+}
+#endif
+
+// -----------------------------------------------------------------------------
+// Tests for cross-thread posting
+// -----------------------------------------------------------------------------
+
+static mu_sched_mpsc_slot_t remote_store[MAX_REMOTE_TEST_THUNKS];
+static mu_sched_mpsc_t remote_q;
+
+static void attach_remote_queue_for_test(void) {
+    TEST_ASSERT_EQUAL(
+        MU_SCHED_MPSC_ERR_NONE,
+        mu_sched_mpsc_init(&remote_q, remote_store, MAX_REMOTE_TEST_THUNKS));
+    mu_sched_set_remote_queue(&remote_q);
+}
+
+void test_mu_sched_mpsc_put_get_full_and_wrap(void) {
+    int items[MAX_REMOTE_TEST_THUNKS + 1];
+    void *item;
+
+    TEST_ASSERT_EQUAL(MU_SCHED_MPSC_ERR_SIZE,
+                      mu_sched_mpsc_init(&remote_q, remote_store, 6));
+    TEST_ASSERT_EQUAL(
+        MU_SCHED_MPSC_ERR_NONE,
+        mu_sched_mpsc_init(&remote_q, remote_store, MAX_REMOTE_TEST_THUNKS));
+    TEST_ASSERT_TRUE(mu_sched_mpsc_is_empty(&remote_q));
+    TEST_ASSERT_EQUAL(MU_SCHED_MPSC_ERR_EMPTY,
+                      mu_sched_mpsc_get(&remote_q, &item));
+
+    // Go around the ring twice, filling it completely each time
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < MAX_REMOTE_TEST_THUNKS; i++) {
+            TEST_ASSERT_EQUAL(MU_SCHED_MPSC_ERR_NONE,
+                              mu_sched_mpsc_put(&remote_q, &items[i]));
+        }
+        TEST_ASSERT_EQUAL(MU_SCHED_MPSC_ERR_FULL,
+                          mu_sched_mpsc_put(&remote_q, &items[8]));
+        for (int i = 0; i < MAX_REMOTE_TEST_THUNKS; i++) {
+            TEST_ASSERT_EQUAL(MU_SCHED_MPSC_ERR_NONE,
+                              mu_sched_mpsc_get(&remote_q, &item));
+            TEST_ASSERT_EQUAL_PTR(&items[i], item);
+        }
+        TEST_ASSERT_TRUE(mu_sched_mpsc_is_empty(&remote_q));
+    }
+}
+
+void test_mu_sched_post_remote_runs_after_isr(void) {
+    counting_thunk_t A, B;
+
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+    counting_thunk_init(&B);
+
+    // No queue attached yet
+    TEST_ASSERT_FALSE(mu_sched_post_remote(&A.thunk));
+
+    attach_remote_queue_for_test();
+    TEST_ASSERT_FALSE(mu_sched_post_remote(NULL));
+    TEST_ASSERT_TRUE(mu_sched_post_remote(&A.thunk));
+    TEST_ASSERT_TRUE(mu_sched_from_isr(&B.thunk));
+    TEST_ASSERT_TRUE(mu_sched_has_runnable_thunk());
+
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(0, A.call_count);
+    TEST_ASSERT_EQUAL_INT(1, B.call_count);
+
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(1, A.call_count);
+    TEST_ASSERT_FALSE(mu_sched_has_runnable_thunk());
+}
+
+void test_mu_sched_post_remote_drains_with_pool_empty(void) {
+    counting_thunk_t A, timer;
+
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+    counting_thunk_init(&timer);
+    attach_remote_queue_for_test();
+
+    // Use up every pool event; bare thunks need no wrapper to drain
+    for (int i = 0; i < MAX_TEST_THUNKS; i++) {
+        TEST_ASSERT_TRUE(mu_sched_in(&timer.thunk, 1000));
+    }
+    TEST_ASSERT_FALSE(mu_sched_in(&timer.thunk, 1000));
+    TEST_ASSERT_TRUE(mu_sched_post_remote(&A.thunk));
+    TEST_ASSERT_TRUE(mu_sched_post_remote(&A.thunk));
+
+    TEST_ASSERT_EQUAL_size_t(2, mu_sched_step_n(4));
+    TEST_ASSERT_EQUAL_INT(2, A.call_count);
+    TEST_ASSERT_EQUAL_INT(0, timer.call_count);
+    mu_sched_set_remote_queue(NULL);
+}
+
+void test_mu_sched_post_remote_drains_in_batches(void) {
+    counting_thunk_t A;
+
+    init_scheduler_for_test();
+    attach_remote_queue_for_test();
+    counting_thunk_init(&A);
+
+    // Twice as many as the asap_q holds
+    for (int i = 0; i < MAX_REMOTE_TEST_THUNKS; i++) {
+        TEST_ASSERT_TRUE(mu_sched_post_remote(&A.thunk));
+    }
+    TEST_ASSERT_EQUAL(MAX_REMOTE_TEST_THUNKS, mu_sched_step_n(100));
+    TEST_ASSERT_EQUAL_INT(MAX_REMOTE_TEST_THUNKS, A.call_count);
+}
+
+#define REMOTE_PRODUCERS 4
+#define REMOTE_POSTS_PER_PRODUCER 2000
+
+static void *remote_producer(void *arg) {
+    mu_thunk_t *thunk = (mu_thunk_t *)arg;
+    for (int i = 0; i < REMOTE_POSTS_PER_PRODUCER; i++) {
+        while (!mu_sched_post_remote(thunk)) {
+            sched_yield(); // Full: let the scheduler thread drain
+        }
+    }
+    return NULL;
+}
+
+void test_mu_sched_post_remote_from_many_threads(void) {
+    counting_thunk_t thunks[REMOTE_PRODUCERS];
+    pthread_t producers[REMOTE_PRODUCERS];
+    int total = 0;
+
+    init_scheduler_for_test();
+    attach_remote_queue_for_test();
+    for (int i = 0; i < REMOTE_PRODUCERS; i++) {
+        counting_thunk_init(&thunks[i]);
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&producers[i], NULL,
+                                                remote_producer,
+                                                &thunks[i].thunk));
+    }
+
+    while (total < REMOTE_PRODUCERS * REMOTE_POSTS_PER_PRODUCER) {
+        size_t ran = mu_sched_step_n(MAX_TEST_THUNKS);
+        if (ran == 0) {
+            sched_yield();
+        }
+        total += (int)ran;
+    }
+
+    for (int i = 0; i < REMOTE_PRODUCERS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(producers[i], NULL));
+        TEST_ASSERT_EQUAL_INT(REMOTE_POSTS_PER_PRODUCER, thunks[i].call_count);
+    }
+    TEST_ASSERT_TRUE(mu_sched_mpsc_is_empty(&remote_q));
+}
+
+// -----------------------------------------------------------------------------
+// Tests for the work-stealing executor
+// -----------------------------------------------------------------------------
+
+#define EXEC_TEST_WORKERS 3
+
+static test_instance_t exec_instances[EXEC_TEST_WORKERS];
+static mu_sched_mpsc_slot_t exec_remote_store[EXEC_TEST_WORKERS]
+                                             [MAX_REMOTE_TEST_THUNKS];
+static mu_sched_mpsc_t exec_remote_q[EXEC_TEST_WORKERS];
+static mu_sched_exec_slot_t exec_ready_store[EXEC_TEST_WORKERS]
+                                            [MAX_TEST_THUNKS];
+static mu_sched_exec_worker_t exec_workers[EXEC_TEST_WORKERS];
+static mu_sched_exec_t exec;
+
+static void init_exec_for_test(void) {
+    for (int i = 0; i < EXEC_TEST_WORKERS; i++) {
+        init_instance_for_test(&exec_instances[i]);
+        mu_sched_set_time_fn_ex(&exec_instances[i].sched, NULL); // real time
+        TEST_ASSERT_EQUAL(MU_SCHED_MPSC_ERR_NONE,
+                          mu_sched_mpsc_init(&exec_remote_q[i],
+                                             exec_remote_store[i],
+                                             MAX_REMOTE_TEST_THUNKS));
+        TEST_ASSERT_TRUE(mu_sched_exec_worker_init(
+            &exec_workers[i], &exec_instances[i].sched, &exec_remote_q[i],
+            exec_ready_store[i], MAX_TEST_THUNKS));
+    }
+    TEST_ASSERT_TRUE(mu_sched_exec_init(&exec, exec_workers,
+                                        EXEC_TEST_WORKERS));
+}
+
+// Yield until `flag` reaches `expected` or about five seconds pass.
+static bool wait_for_flag(atomic_int *flag, int expected) {
+    mu_time_abs_t give_up = mu_time_offset(mu_time_now(), 5000000000LL);
+    while (atomic_load(flag) < expected) {
+        if (mu_time_is_after(mu_time_now(), give_up)) {
+            return false;
+        }
+        sched_yield();
+    }
+    return true;
+}
+
+static atomic_int exec_runs;
+static atomic_int exec_seen_mask;
+
+// Records the worker it runs on, then waits until some other worker has
+// also run a thunk.
+static void stealable_thunk_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+    mu_sched_t *self = mu_sched_exec_current();
+    for (int i = 0; i < EXEC_TEST_WORKERS; i++) {
+        if (self == &exec_instances[i].sched) {
+            atomic_fetch_or(&exec_seen_mask, 1 << i);
+        }
+    }
+    mu_time_abs_t give_up = mu_time_offset(mu_time_now(), 5000000000LL);
+    int mask = atomic_load(&exec_seen_mask);
+    while (!(mask & (mask - 1)) && !mu_time_is_after(mu_time_now(), give_up)) {
+        sched_yield(); // wait for a second worker to show up
+        mask = atomic_load(&exec_seen_mask);
+    }
+    atomic_fetch_add(&exec_runs, 1);
+}
+
+void test_mu_sched_exec_idle_worker_steals(void) {
+    mu_thunk_t thunks[MAX_TEST_THUNKS];
+
+    atomic_store(&exec_runs, 0);
+    atomic_store(&exec_seen_mask, 0);
+    init_exec_for_test();
+    TEST_ASSERT_NULL(mu_sched_exec_current());
+
+    // Queue everything on worker 0 before the pool starts
+    for (int i = 0; i < MAX_TEST_THUNKS; i++) {
+        mu_thunk_init(&thunks[i], stealable_thunk_fn);
+        TEST_ASSERT_TRUE(
+            mu_sched_now_ex(&exec_instances[0].sched, &thunks[i]));
+    }
+    TEST_ASSERT_TRUE(mu_sched_exec_start(&exec));
+    TEST_ASSERT_TRUE(wait_for_flag(&exec_runs, MAX_TEST_THUNKS));
+    mu_sched_exec_stop(&exec);
+
+    int mask = atomic_load(&exec_seen_mask);
+    TEST_ASSERT_TRUE(mask & 1);
+    TEST_ASSERT_TRUE(mask & (mask - 1));
+}
+
+static atomic_int exec_active;
+static atomic_int exec_overlaps;
+
+// Counts the times it finds another copy of itself already running.
+static void reposted_thunk_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+    if (atomic_fetch_add(&exec_active, 1) != 0) {
+        atomic_fetch_add(&exec_overlaps, 1);
+    }
+    for (int i = 0; i < 100; i++) {
+        sched_yield(); // give a thief time to take another copy
+    }
+    atomic_fetch_sub(&exec_active, 1);
+    atomic_fetch_add(&exec_runs, 1);
+}
+
+void test_mu_sched_exec_reposted_thunk_never_overlaps(void) {
+    mu_thunk_t thunk;
+
+    atomic_store(&exec_runs, 0);
+    atomic_store(&exec_active, 0);
+    atomic_store(&exec_overlaps, 0);
+    init_exec_for_test();
+    mu_thunk_init(&thunk, reposted_thunk_fn);
+
+    // Several copies of one thunk, all on worker 0's remote queue
+    for (int i = 0; i < EXEC_TEST_WORKERS * 2; i++) {
+        TEST_ASSERT_TRUE(
+            mu_sched_post_remote_ex(&exec_instances[0].sched, &thunk));
+    }
+    TEST_ASSERT_TRUE(mu_sched_exec_start(&exec));
+    TEST_ASSERT_TRUE(wait_for_flag(&exec_runs, EXEC_TEST_WORKERS * 2));
+    mu_sched_exec_stop(&exec);
+
+    TEST_ASSERT_EQUAL_INT(0, atomic_load(&exec_overlaps));
+}
+
+static atomic_int exec_timer_fired;
+static mu_sched_t *exec_timer_owner;
+
+static void exec_timer_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+    atomic_fetch_add(&exec_timer_fired, 1);
+}
+
+static mu_thunk_t exec_timer_thunk;
+
+static void exec_arm_fn(mu_thunk_t *thunk, void *args) {
+    (void)thunk;
+    (void)args;
+    exec_timer_owner = mu_sched_exec_current();
+    mu_sched_in_ex(exec_timer_owner, &exec_timer_thunk, 2000000); // 2 ms
+}
+
+void test_mu_sched_exec_post_and_timers(void) {
+    mu_thunk_t arm;
+
+    atomic_store(&exec_timer_fired, 0);
+    exec_timer_owner = NULL;
+    init_exec_for_test();
+    mu_thunk_init(&arm, exec_arm_fn);
+    mu_thunk_init(&exec_timer_thunk, exec_timer_fn);
+
+    TEST_ASSERT_TRUE(mu_sched_exec_start(&exec));
+    TEST_ASSERT_TRUE(mu_sched_exec_post(&exec, &arm));
+    TEST_ASSERT_TRUE(wait_for_flag(&exec_timer_fired, 1));
+    mu_sched_exec_stop(&exec);
+
+    TEST_ASSERT_NOT_NULL(exec_timer_owner);
+}
+
+// -----------------------------------------------------------------------------
+// Tests for multiple scheduler instances
+// -----------------------------------------------------------------------------
+
+// Records which instance the scheduler reports while the thunk runs.
+static mu_sched_t *instance_under_test;
+
+static void instance_thunk_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    TEST_ASSERT_EQUAL_PTR(thunk,
+                          mu_sched_current_thunk_ex(instance_under_test));
+    counting_thunk_fn(thunk, NULL);
+}
+
+void test_mu_sched_instances_are_independent(void) {
+    static test_instance_t one, two;
+    counting_thunk_t A, B, C;
+
+    init_scheduler_for_test();
+    init_instance_for_test(&one);
+    init_instance_for_test(&two);
+    counting_thunk_init(&A);
+    counting_thunk_init(&B);
+    counting_thunk_init(&C);
+    mu_thunk_init(&A.thunk, instance_thunk_fn);
+    mu_thunk_init(&B.thunk, instance_thunk_fn);
+
+    TEST_ASSERT_TRUE(mu_sched_now_ex(&one.sched, &A.thunk));
+    TEST_ASSERT_TRUE(mu_sched_at_ex(&two.sched, &B.thunk, mk_time(0, 5)));
+    TEST_ASSERT_TRUE(mu_sched_now(&C.thunk));
+
+    TEST_ASSERT_TRUE(mu_sched_has_runnable_thunk_ex(&one.sched));
+    TEST_ASSERT_FALSE(mu_sched_has_runnable_thunk_ex(&two.sched));
+
+    set_virtual_time(mk_time(0, 5));
+    instance_under_test = &two.sched;
+    mu_sched_step_ex(&two.sched);
+    TEST_ASSERT_EQUAL_INT(0, A.call_count);
+    TEST_ASSERT_EQUAL_INT(1, B.call_count);
+
+    instance_under_test = &one.sched;
+    mu_sched_step_ex(&one.sched);
+    TEST_ASSERT_EQUAL_INT(1, A.call_count);
+
+    // The default instance still holds C, and only C
+    TEST_ASSERT_EQUAL_INT(0, C.call_count);
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(1, C.call_count);
+    TEST_ASSERT_EQUAL_INT(1, A.call_count);
+    TEST_ASSERT_EQUAL_INT(1, B.call_count);
+}
+
+void test_mu_sched_uninitialized_instance_is_rejected(void) {
+    static mu_sched_t blank;
+    counting_thunk_t A;
+
+    counting_thunk_init(&A);
+    TEST_ASSERT_FALSE(mu_sched_now_ex(&blank, &A.thunk));
+    TEST_ASSERT_FALSE(mu_sched_now_ex(NULL, &A.thunk));
+    TEST_ASSERT_FALSE(mu_sched_init_ex(NULL, NULL, NULL, NULL, NULL));
+    mu_sched_step_ex(&blank);
+    mu_sched_step_ex(NULL);
+    TEST_ASSERT_EQUAL_INT(0, A.call_count);
+}
+
+// -----------------------------------------------------------------------------
+// Tests for the timer wheel event store
+// -----------------------------------------------------------------------------
+
+void test_mu_sched_wheel_respects_delay(void) {
+    counting_thunk_t A;
+
+    init_wheel_scheduler_for_test(1);
+    counting_thunk_init(&A);
+
+    TEST_ASSERT_TRUE(mu_sched_at(&A.thunk, mk_time(0, 5)));
+
+    set_virtual_time(mk_time(0, 4));
+    mu_sched_step();
+    TEST_ASSERT_EQUAL(0, A.call_count);
+
+    set_virtual_time(mk_time(0, 5));
+    mu_sched_step();
+    TEST_ASSERT_EQUAL(1, A.call_count);
+
+    set_virtual_time(mk_time(0, 6));
+    mu_sched_step();
+    TEST_ASSERT_EQUAL(1, A.call_count);
+}
+
+void test_mu_sched_wheel_sub_tick_timestamps(void) {
+    counting_thunk_t A;
+
+    // 1 ms ticks: the event and "now" share a tick but A is not yet due.
+    init_wheel_scheduler_for_test(1000000);
+    counting_thunk_init(&A);
+
+    TEST_ASSERT_TRUE(mu_sched_at(&A.thunk, mk_time(0, 1500000)));
+
+    set_virtual_time(mk_time(0, 1200000));
+    mu_sched_step();
+    TEST_ASSERT_EQUAL(0, A.call_count);
+
+    set_virtual_time(mk_time(0, 1500000));
+    mu_sched_step();
+    TEST_ASSERT_EQUAL(1, A.call_count);
+}
+
+void test_mu_sched_wheel_earliest_first(void) {
+    order_thunk_t T[MAX_WHEEL_TEST_EVENTS];
+    // Deliberately scrambled; spans sub-tick, near, far and overflow ranges.
+    static const long offsets_ns[MAX_WHEEL_TEST_EVENTS] = {
+        900000000, 3,        70,       4096,    5,       1000000, 262144, 64,
+        20000000,  16777216, 99999999, 4095,    1,       2,       65,     600};
+
+    init_wheel_scheduler_for_test(1);
+    for (int i = 0; i < MAX_WHEEL_TEST_EVENTS; i++) {
+        order_thunk_init(&T[i], i);
+        TEST_ASSERT_TRUE(
+            mu_sched_at(&T[i].thunk, mk_time(1, offsets_ns[i])));
+    }
+
+    set_virtual_time(mk_time(1, 1000000000)); // past the latest offset
+    for (int i = 0; i < MAX_WHEEL_TEST_EVENTS; i++) {
+        mu_sched_step();
+    }
+
+    TEST_ASSERT_EQUAL_INT(MAX_WHEEL_TEST_EVENTS, order_log_count);
+    for (int i = 1; i < MAX_WHEEL_TEST_EVENTS; i++) {
+        TEST_ASSERT_TRUE(offsets_ns[order_log[i - 1]] <
+                         offsets_ns[order_log[i]]);
+    }
+}
+
+void test_mu_sched_wheel_tied_fifo_across_levels(void) {
+    order_thunk_t A, B, C;
+
+    init_wheel_scheduler_for_test(1);
+    order_thunk_init(&A, 0);
+    order_thunk_init(&B, 1);
+    order_thunk_init(&C, 2);
+
+    mu_time_abs_t t = mk_time(7, 7);
+    // A is inserted while t is far away (overflow list)...
+    TEST_ASSERT_TRUE(mu_sched_at(&A.thunk, t));
+
+    // ... B once time has advanced close to t (a low wheel level) ...
+    set_virtual_time(mk_time(7, 0));
+    mu_sched_step();
+    TEST_ASSERT_TRUE(mu_sched_at(&B.thunk, t));
+
+    // ... and C when t is already due (straight onto the expiry list).
+    set_virtual_time(mk_time(8, 0));
+    mu_sched_step(); // Runs A
+    TEST_ASSERT_TRUE(mu_sched_at(&C.thunk, t));
+    mu_sched_step();
+    mu_sched_step();
+
+    TEST_ASSERT_EQUAL_INT(3, order_log_count);
+    TEST_ASSERT_EQUAL_INT(0, order_log[0]);
+    TEST_ASSERT_EQUAL_INT(1, order_log[1]);
+    TEST_ASSERT_EQUAL_INT(2, order_log[2]);
+}
+
+void test_mu_sched_wheel_delete_thunk_events(void) {
+    counting_thunk_t A, B;
+
+    init_wheel_scheduler_for_test(1);
+    counting_thunk_init(&A);
+    counting_thunk_init(&B);
+
+    TEST_ASSERT_TRUE(mu_sched_at(&A.thunk, mk_time(0, 10)));
+    TEST_ASSERT_TRUE(mu_sched_at(&A.thunk, mk_time(50, 0)));
+    TEST_ASSERT_TRUE(mu_sched_at(&B.thunk, mk_time(0, 10)));
+    TEST_ASSERT_TRUE(mu_sched_at(&A.thunk, mk_time(0, 0)));
+
+    TEST_ASSERT_EQUAL_INT(3, mu_sched_delete_thunk_events(&A.thunk));
+
+    set_virtual_time(mk_time(60, 0));
+    mu_sched_step();
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(0, A.call_count);
+    TEST_ASSERT_EQUAL_INT(1, B.call_count);
+}
+
+// -----------------------------------------------------------------------------
+// Tests for the heap event store
+// -----------------------------------------------------------------------------
+
+static void check_heap_earliest_first_ties_fifo(void) {
+    order_thunk_t T[MAX_WHEEL_TEST_EVENTS];
+    // Scrambled, with repeated timestamps
+    static const long offsets_ns[MAX_WHEEL_TEST_EVENTS] = {
+        50, 3, 70, 3, 5, 50, 1, 64, 3, 16, 99, 50, 1, 2, 65, 600};
+
+    for (int i = 0; i < MAX_WHEEL_TEST_EVENTS; i++) {
+        order_thunk_init(&T[i], i);
+        TEST_ASSERT_TRUE(
+            mu_sched_at(&T[i].thunk, mk_time(0, offsets_ns[i])));
+    }
+    // Full
+    TEST_ASSERT_FALSE(mu_sched_at(&T[0].thunk, mk_time(0, 0)));
+
+    set_virtual_time(mk_time(1, 0));
+    for (int i = 0; i < MAX_WHEEL_TEST_EVENTS; i++) {
+        mu_sched_step();
+    }
+
+    TEST_ASSERT_EQUAL_INT(MAX_WHEEL_TEST_EVENTS, order_log_count);
+    for (int i = 1; i < MAX_WHEEL_TEST_EVENTS; i++) {
+        long prev = offsets_ns[order_log[i - 1]];
+        long cur = offsets_ns[order_log[i]];
+        TEST_ASSERT_TRUE(prev < cur ||
+                         (prev == cur && order_log[i - 1] < order_log[i]));
+    }
+}
+
+static void check_heap_cancel_and_delete(void) {
+    order_thunk_t T[8];
+    mu_sched_handle_t handles[8];
+
+    for (int i = 0; i < 8; i++) {
+        order_thunk_init(&T[i], i);
+        TEST_ASSERT_TRUE(
+            mu_sched_at_handle(&T[i].thunk, mk_time(0, 80 - 10 * i),
+                               &handles[i]));
+    }
+    // Cancel from the root, a leaf and the middle of the heap
+    TEST_ASSERT_TRUE(mu_sched_cancel(&handles[7]));
+    TEST_ASSERT_TRUE(mu_sched_cancel(&handles[0]));
+    TEST_ASSERT_TRUE(mu_sched_cancel(&handles[4]));
+    TEST_ASSERT_EQUAL_INT(1, mu_sched_delete_thunk_events(&T[2].thunk));
+
+    set_virtual_time(mk_time(1, 0));
+    for (int i = 0; i < 8; i++) {
+        mu_sched_step();
+    }
+    // Survivors 6, 5, 3, 1 by ascending timestamp
+    TEST_ASSERT_EQUAL_INT(4, order_log_count);
+    TEST_ASSERT_EQUAL_INT(6, order_log[0]);
+    TEST_ASSERT_EQUAL_INT(5, order_log[1]);
+    TEST_ASSERT_EQUAL_INT(3, order_log[2]);
+    TEST_ASSERT_EQUAL_INT(1, order_log[3]);
+}
+
+void test_mu_sched_heap_earliest_first_ties_fifo(void) {
+    init_heap_scheduler_for_test();
+    check_heap_earliest_first_ties_fifo();
+}
+
+void test_mu_sched_heap_cancel_and_delete(void) {
+    init_heap_scheduler_for_test();
+    check_heap_cancel_and_delete();
+}
+
+void test_mu_sched_keyed_heap_earliest_first_ties_fifo(void) {
+    init_heap_scheduler_with_keys(true);
+    check_heap_earliest_first_ties_fifo();
+}
+
+void test_mu_sched_keyed_heap_cancel_and_delete(void) {
+    init_heap_scheduler_with_keys(true);
+    check_heap_cancel_and_delete();
+}
+
+void test_mu_sched_heap_every_keeps_phase_and_skips_missed(void) {
+    init_heap_scheduler_for_test();
+    check_every_keeps_phase_and_skips_missed();
+}
+
+// -----------------------------------------------------------------------------
+// Tests for the EDF ready queue
+// -----------------------------------------------------------------------------
+
+void test_mu_sched_edf_runs_most_urgent_first(void) {
+    static mu_sched_edf_entry_t edf_store[MAX_TEST_THUNKS];
+    mu_sched_edf_t edf;
+    order_thunk_t late, bulk1, bulk2, urgent;
+
+    init_scheduler_for_test();
+    TEST_ASSERT_NULL(mu_sched_edf_init(&edf, edf_store, 0));
+    TEST_ASSERT_NOT_NULL(mu_sched_edf_init(&edf, edf_store, MAX_TEST_THUNKS));
+    mu_sched_set_edf_queue(&edf);
+    order_log_count = 0;
+    order_thunk_init(&late, 0);
+    order_thunk_init(&bulk1, 1);
+    order_thunk_init(&bulk2, 2);
+    order_thunk_init(&urgent, 3);
+
+    // A timed thunk due at t=2 is promoted late, after bulk work queued at t=5
+    TEST_ASSERT_TRUE(mu_sched_at(&late.thunk, mk_time(2, 0)));
+    set_virtual_time(mk_time(5, 0));
+    TEST_ASSERT_TRUE(mu_sched_now(&bulk1.thunk));
+    TEST_ASSERT_TRUE(mu_sched_now(&bulk2.thunk));
+    TEST_ASSERT_TRUE(mu_sched_now_deadline(&urgent.thunk, mk_time(1, 0)));
+
+    for (int i = 0; i < 4; i++) {
+        mu_sched_step();
+    }
+    TEST_ASSERT_EQUAL_INT(4, order_log_count);
+    TEST_ASSERT_EQUAL_INT(3, order_log[0]); // deadline t=1
+    TEST_ASSERT_EQUAL_INT(0, order_log[1]); // due at t=2
+    TEST_ASSERT_EQUAL_INT(1, order_log[2]); // ready at t=5, FIFO
+    TEST_ASSERT_EQUAL_INT(2, order_log[3]);
+    TEST_ASSERT_FALSE(mu_sched_has_runnable_thunk());
+}
+
+void test_mu_sched_edf_full_and_detach(void) {
+    static mu_sched_edf_entry_t edf_store[2];
+    mu_sched_edf_t edf;
+    order_thunk_t T[3];
+
+    init_scheduler_for_test();
+    mu_sched_edf_init(&edf, edf_store, 2);
+    mu_sched_set_edf_queue(&edf);
+    order_log_count = 0;
+    for (int i = 0; i < 3; i++) {
+        order_thunk_init(&T[i], i);
+    }
+    TEST_ASSERT_TRUE(mu_sched_now_deadline(&T[0].thunk, mk_time(3, 0)));
+    TEST_ASSERT_TRUE(mu_sched_now_deadline(&T[1].thunk, mk_time(4, 0)));
+    TEST_ASSERT_FALSE(mu_sched_now_deadline(&T[2].thunk, mk_time(1, 0)));
+    TEST_ASSERT_EQUAL_size_t(2, mu_sched_edf_count(&edf));
+
+    // Detached: deadlines are ignored and the asap_q is FIFO again
+    mu_sched_set_edf_queue(NULL);
+    mu_sched_edf_init(&edf, edf_store, 2);
+    TEST_ASSERT_TRUE(mu_sched_now_deadline(&T[1].thunk, mk_time(4, 0)));
+    TEST_ASSERT_TRUE(mu_sched_now_deadline(&T[0].thunk, mk_time(3, 0)));
+    mu_sched_step();
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(2, order_log_count);
+    TEST_ASSERT_EQUAL_INT(1, order_log[0]);
+    TEST_ASSERT_EQUAL_INT(0, order_log[1]);
+}
+
+// -----------------------------------------------------------------------------
+// Tests for priority levels
+// -----------------------------------------------------------------------------
+
+void test_mu_sched_prio_highest_level_first(void) {
+    static void *low_store[MAX_TEST_THUNKS];
+    static void *high_store[MAX_TEST_THUNKS];
+    mu_pqueue_t low_q, high_q;
+    order_thunk_t bulk, low, high1, high2, isr;
+
+    init_scheduler_for_test();
+    order_log_count = 0;
+    mu_pqueue_init(&low_q, low_store, MAX_TEST_THUNKS);
+    mu_pqueue_init(&high_q, high_store, MAX_TEST_THUNKS);
+    order_thunk_init(&bulk, 0);
+    order_thunk_init(&low, 1);
+    order_thunk_init(&high1, 2);
+    order_thunk_init(&high2, 3);
+    order_thunk_init(&isr, 4);
+
+    // Levels must be in range and attached
+    TEST_ASSERT_FALSE(mu_sched_set_prio_queue(MU_SCHED_PRIO_LEVELS, &low_q));
+    TEST_ASSERT_FALSE(mu_sched_now_prio(&low.thunk, 1));
+    TEST_ASSERT_TRUE(mu_sched_set_prio_queue(1, &low_q));
+    TEST_ASSERT_TRUE(mu_sched_set_prio_queue(MU_SCHED_PRIO_LEVELS - 1,
+                                             &high_q));
+
+    TEST_ASSERT_TRUE(mu_sched_now(&bulk.thunk));
+    TEST_ASSERT_TRUE(mu_sched_now_prio(&low.thunk, 1));
+    TEST_ASSERT_TRUE(
+        mu_sched_now_prio(&high1.thunk, MU_SCHED_PRIO_LEVELS - 1));
+    TEST_ASSERT_TRUE(
+        mu_sched_now_prio(&high2.thunk, MU_SCHED_PRIO_LEVELS - 1));
+    TEST_ASSERT_TRUE(mu_sched_from_isr(&isr.thunk));
+
+    for (int i = 0; i < 5; i++) {
+        mu_sched_step();
+    }
+    TEST_ASSERT_EQUAL_INT(5, order_log_count);
+    TEST_ASSERT_EQUAL_INT(4, order_log[0]); // interrupt queue
+    TEST_ASSERT_EQUAL_INT(2, order_log[1]); // top level, FIFO
+    TEST_ASSERT_EQUAL_INT(3, order_log[2]);
+    TEST_ASSERT_EQUAL_INT(1, order_log[3]); // level 1
+    TEST_ASSERT_EQUAL_INT(0, order_log[4]); // asap_q
+    TEST_ASSERT_FALSE(mu_sched_has_runnable_thunk());
+}
+
+// -----------------------------------------------------------------------------
+// Tests for overload policies
+// -----------------------------------------------------------------------------
+
+/*
+ * Fills the asap_q (capacity MAX_TEST_THUNKS) with T[0..MAX_TEST_THUNKS-1]
+ * and schedules T[MAX_TEST_THUNKS] as a due event.
+ */
+static void overload_for_test(order_thunk_t *T, mu_sched_overload_t policy) {
+    init_scheduler_for_test();
+    order_log_count = 0;
+    mu_sched_set_overload_policy(policy);
+    for (int i = 0; i <= MAX_TEST_THUNKS; i++) {
+        order_thunk_init(&T[i], i);
+    }
+    for (int i = 0; i < MAX_TEST_THUNKS; i++) {
+        TEST_ASSERT_TRUE(mu_sched_now(&T[i].thunk));
+    }
+    TEST_ASSERT_TRUE(mu_sched_at(&T[MAX_TEST_THUNKS].thunk, mk_time(0, 0)));
+}
+
+void test_mu_sched_overload_defer_keeps_due_events(void) {
+    order_thunk_t T[MAX_TEST_THUNKS + 1];
+    const mu_sched_overload_stats_t *stats;
+
+    overload_for_test(T, MU_SCHED_OVERLOAD_DEFER);
+    TEST_ASSERT_FALSE(mu_sched_now(&T[0].thunk));
+    for (int i = 0; i <= MAX_TEST_THUNKS; i++) {
+        mu_sched_step();
+    }
+    // The due event waited for room, then ran last
+    TEST_ASSERT_EQUAL_INT(MAX_TEST_THUNKS + 1, order_log_count);
+    TEST_ASSERT_EQUAL_INT(MAX_TEST_THUNKS, order_log[MAX_TEST_THUNKS]);
+
+    stats = mu_sched_overload_stats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats->rejected);
+    TEST_ASSERT_EQUAL_UINT32(1, stats->deferred);
+    TEST_ASSERT_EQUAL_UINT32(0, stats->dropped_due);
+    TEST_ASSERT_EQUAL_size_t(MAX_TEST_THUNKS, stats->ready_hwm);
+    TEST_ASSERT_EQUAL_size_t(1, stats->event_hwm);
+
+    mu_sched_overload_stats_reset();
+    TEST_ASSERT_EQUAL_UINT32(0, stats->rejected);
+    TEST_ASSERT_EQUAL_size_t(0, stats->ready_hwm);
+}
+
+void test_mu_sched_overload_drop_newest(void) {
+    order_thunk_t T[MAX_TEST_THUNKS + 1];
+    mu_time_abs_t deadline;
+
+    overload_for_test(T, MU_SCHED_OVERLOAD_DROP_NEWEST);
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_UINT32(1, mu_sched_overload_stats()->dropped_due);
+    TEST_ASSERT_FALSE(mu_sched_next_deadline(&deadline));
+    for (int i = 0; i < MAX_TEST_THUNKS; i++) {
+        mu_sched_step();
+    }
+    TEST_ASSERT_EQUAL_INT(MAX_TEST_THUNKS, order_log_count);
+    TEST_ASSERT_EQUAL_INT(MAX_TEST_THUNKS - 1, order_log[MAX_TEST_THUNKS - 1]);
+}
+
+void test_mu_sched_overload_drop_oldest(void) {
+    order_thunk_t T[MAX_TEST_THUNKS + 1];
+
+    overload_for_test(T, MU_SCHED_OVERLOAD_DROP_OLDEST);
+    for (int i = 0; i < MAX_TEST_THUNKS; i++) {
+        mu_sched_step();
+    }
+    // Promoting the due event evicted T[0]
+    TEST_ASSERT_EQUAL_UINT32(1, mu_sched_overload_stats()->dropped_ready);
+    TEST_ASSERT_EQUAL_INT(MAX_TEST_THUNKS, order_log_count);
+    TEST_ASSERT_EQUAL_INT(1, order_log[0]);
+    TEST_ASSERT_EQUAL_INT(MAX_TEST_THUNKS, order_log[MAX_TEST_THUNKS - 1]);
+}
+
+// -----------------------------------------------------------------------------
+// Tests for coroutines
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    mu_coro_t coro; // must be first
+    int step;       // last step reached
+    int loops;
+    bool ready;
+} coro_test_t;
+
+static void coro_test_fn(mu_thunk_t *thunk, void *args) {
+    coro_test_t *self = (coro_test_t *)thunk;
+    (void)args;
+
+    MU_CORO_BEGIN(&self->coro);
+    self->step = 1;
+    MU_CORO_AWAIT_DELAY(&self->coro, TU(10));
+    self->step = 2;
+    for (self->loops = 0; self->loops < 2; self->loops++) {
+        MU_CORO_YIELD(&self->coro);
+    }
+    self->step = 3;
+    MU_CORO_AWAIT_UNTIL(&self->coro, self->ready);
+    self->step = 4;
+    MU_CORO_END(&self->coro);
+}
+
+void test_mu_sched_coro_awaits_delay_yield_and_condition(void) {
+    coro_test_t ct = {.step = 0, .ready = false};
+
+    init_scheduler_for_test();
+    mu_coro_init(&ct.coro, coro_test_fn, NULL);
+    TEST_ASSERT_TRUE(mu_coro_start(&ct.coro));
+
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(1, ct.step);
+    mu_sched_step(); // still waiting for t=10
+    TEST_ASSERT_EQUAL_INT(1, ct.step);
+
+    set_virtual_time(mk_time(0, 10));
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(2, ct.step);
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(1, ct.loops);
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(3, ct.step);
+
+    // Polls until ready
+    mu_sched_step();
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(3, ct.step);
+    TEST_ASSERT_FALSE(mu_coro_is_done(&ct.coro));
+    ct.ready = true;
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(4, ct.step);
+    TEST_ASSERT_TRUE(mu_coro_is_done(&ct.coro));
+    TEST_ASSERT_FALSE(ct.coro.failed);
+    TEST_ASSERT_FALSE(mu_sched_has_runnable_thunk());
+
+    // Running a finished coroutine does nothing; restart rewinds it
+    ct.step = 0;
+    mu_coro_start(&ct.coro);
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(0, ct.step);
+    mu_coro_restart(&ct.coro);
+    mu_coro_start(&ct.coro);
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(1, ct.step);
+}
+
+// -----------------------------------------------------------------------------
+// Tests for signals
+// -----------------------------------------------------------------------------
+
+void test_mu_sched_signal_wakes_waiters_in_order(void) {
+    static mu_thunk_t *waiters[3];
+    mu_sched_signal_t sig;
+    order_thunk_t T[4];
+
+    init_scheduler_for_test();
+    order_log_count = 0;
+    TEST_ASSERT_NULL(mu_sched_signal_init(&sig, waiters, 0));
+    TEST_ASSERT_NOT_NULL(mu_sched_signal_init(&sig, waiters, 3));
+    for (int i = 0; i < 4; i++) {
+        order_thunk_init(&T[i], i);
+    }
+    TEST_ASSERT_EQUAL_size_t(0, mu_sched_signal_raise(&sig));
+
+    TEST_ASSERT_TRUE(mu_sched_signal_wait(&sig, &T[2].thunk));
+    TEST_ASSERT_TRUE(mu_sched_signal_wait(&sig, &T[0].thunk));
+    TEST_ASSERT_TRUE(mu_sched_signal_wait(&sig, &T[1].thunk));
+    TEST_ASSERT_FALSE(mu_sched_signal_wait(&sig, &T[3].thunk));
+    TEST_ASSERT_EQUAL_size_t(1, mu_sched_signal_remove(&sig, &T[0].thunk));
+
+    // Waiting costs no scheduler work
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(0, order_log_count);
+
+    TEST_ASSERT_EQUAL_size_t(2, mu_sched_signal_raise(&sig));
+    TEST_ASSERT_EQUAL_size_t(0, mu_sched_signal_waiter_count(&sig));
+    mu_sched_step();
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(2, order_log_count);
+    TEST_ASSERT_EQUAL_INT(2, order_log[0]);
+    TEST_ASSERT_EQUAL_INT(1, order_log[1]);
+}
+
+void test_mu_sched_signal_raise_from_isr_coalesces(void) {
+    static mu_thunk_t *waiters[2];
+    mu_sched_signal_t sig;
+    counting_thunk_t A;
+
+    init_scheduler_for_test();
+    mu_sched_signal_init(&sig, waiters, 2);
+    counting_thunk_init(&A);
+    mu_sched_signal_wait(&sig, &A.thunk);
+
+    TEST_ASSERT_TRUE(mu_sched_signal_raise_from_isr(&sig));
+    TEST_ASSERT_TRUE(mu_sched_signal_raise_from_isr(&sig));
+    mu_sched_step(); // the signal's own thunk moves the waiter
+    TEST_ASSERT_EQUAL(0, A.call_count);
+    mu_sched_step();
+    TEST_ASSERT_EQUAL(1, A.call_count);
+    mu_sched_step(); // the second raise was coalesced into the first
+    TEST_ASSERT_EQUAL(1, A.call_count);
+    TEST_ASSERT_FALSE(mu_sched_has_runnable_thunk());
+}
+
+typedef struct {
+    mu_coro_t coro; // must be first
+    mu_sched_signal_t *sig;
+    int wakeups;
+} coro_signal_test_t;
+
+static void coro_signal_test_fn(mu_thunk_t *thunk, void *args) {
+    coro_signal_test_t *self = (coro_signal_test_t *)thunk;
+    (void)args;
+
+    MU_CORO_BEGIN(&self->coro);
+    for (;;) {
+        MU_CORO_AWAIT_SIGNAL(&self->coro, self->sig);
+        self->wakeups++;
+    }
+    MU_CORO_END(&self->coro);
+}
+
+void test_mu_sched_coro_awaits_signal(void) {
+    static mu_thunk_t *waiters[1];
+    mu_sched_signal_t sig;
+    coro_signal_test_t ct = {.sig = &sig, .wakeups = 0};
+
+    init_scheduler_for_test();
+    mu_sched_signal_init(&sig, waiters, 1);
+    mu_coro_init(&ct.coro, coro_signal_test_fn, NULL);
+    mu_coro_start(&ct.coro);
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_size_t(1, mu_sched_signal_waiter_count(&sig));
+
+    for (int i = 1; i <= 3; i++) {
+        mu_sched_signal_raise(&sig);
+        mu_sched_step();
+        TEST_ASSERT_EQUAL_INT(i, ct.wakeups);
+        TEST_ASSERT_EQUAL_size_t(1, mu_sched_signal_waiter_count(&sig));
+    }
+    TEST_ASSERT_FALSE(ct.coro.failed);
+}
+
+// -----------------------------------------------------------------------------
+// Tests for mu_sched_in_slack()
+// -----------------------------------------------------------------------------
+
+void test_mu_sched_in_slack_joins_pending_event(void) {
+    counting_thunk_t A, B, C;
+    mu_time_abs_t deadline;
+
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+    counting_thunk_init(&B);
+    counting_thunk_init(&C);
+
+    TEST_ASSERT_TRUE(mu_sched_in_slack(&A.thunk, TU(1000), 0, NULL));
+    // Window [900, 1100] contains A's deadline: B is moved onto it
+    TEST_ASSERT_TRUE(mu_sched_in_slack(&B.thunk, TU(900), TU(200), NULL));
+    // Window [1001, 1050] does not: C is not moved
+    TEST_ASSERT_TRUE(mu_sched_in_slack(&C.thunk, TU(1001), TU(49), NULL));
+    TEST_ASSERT_FALSE(mu_sched_in_slack(&C.thunk, TU(1001), -1, NULL));
+
+    TEST_ASSERT_TRUE(mu_sched_next_deadline(&deadline));
+    TEST_ASSERT_EQUAL_INT(TU(1000), deadline.nanoseconds);
+
+    // One promotion pass at t=1000 releases both A and B
+    set_virtual_time(mk_time(0, 1000));
+    TEST_ASSERT_EQUAL_size_t(2, mu_sched_step_n(4));
+    TEST_ASSERT_EQUAL(1, A.call_count);
+    TEST_ASSERT_EQUAL(1, B.call_count);
+    TEST_ASSERT_EQUAL(0, C.call_count);
+}
+
+void test_mu_sched_in_slack_aligns_to_power_of_two(void) {
+    counting_thunk_t A, B;
+    mu_time_abs_t deadline;
+
+#ifdef MU_SCHED_TICK_EVENTS
+    TEST_IGNORE_MESSAGE("slack grains are nanoseconds, not whole ticks");
+#endif
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+    counting_thunk_init(&B);
+
+    // Slack 300 -> 256 ns grain: the window [1000, 1300] aligns to 1024
+    TEST_ASSERT_TRUE(mu_sched_in_slack(&A.thunk, 1000, 300, NULL));
+    TEST_ASSERT_TRUE(mu_sched_next_deadline(&deadline));
+    TEST_ASSERT_EQUAL_INT(1024, deadline.nanoseconds);
+
+    // An independent timer with similar slack lands on the same boundary
+    set_virtual_time(mk_time(0, 10));
+    TEST_ASSERT_TRUE(mu_sched_in_slack(&B.thunk, 1000, 256, NULL));
+    set_virtual_time(mk_time(0, 1024));
+    TEST_ASSERT_EQUAL_size_t(2, mu_sched_step_n(4));
+}
+
+// -----------------------------------------------------------------------------
+// Tests for simulation mode
+// -----------------------------------------------------------------------------
+
+void test_mu_sched_sim_step_jumps_to_next_deadline(void) {
+    counting_thunk_t A, idle;
+
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+    counting_thunk_init(&idle);
+    mu_sched_set_idle_thunk(&idle.thunk);
+    mu_sched_sim_start(mk_time(100, 0));
+    TEST_ASSERT_EQUAL_INT(100, mu_sched_current_time().seconds);
+
+    TEST_ASSERT_TRUE(mu_sched_in(&A.thunk, 5 * 1000000000LL));
+    mu_sched_step(); // nothing ready: jump to t=105 and run A
+    TEST_ASSERT_EQUAL(1, A.call_count);
+    TEST_ASSERT_EQUAL(0, idle.call_count);
+    TEST_ASSERT_EQUAL_INT(105, mu_sched_current_time().seconds);
+
+    mu_sched_step(); // nothing pending: idle, time stands still
+    TEST_ASSERT_EQUAL(1, idle.call_count);
+    mu_sched_sim_advance(1000000000LL);
+    TEST_ASSERT_EQUAL_INT(106, mu_sched_current_time().seconds);
+
+    mu_sched_sim_stop();
+    TEST_ASSERT_EQUAL_INT(0, mu_sched_current_time().seconds);
+}
+
+void test_mu_sched_sim_run_until_covers_an_hour(void) {
+    counting_thunk_t tick, once;
+
+    init_scheduler_for_test();
+    counting_thunk_init(&tick);
+    counting_thunk_init(&once);
+    TEST_ASSERT_EQUAL_size_t(0, mu_sched_sim_run_until(mk_time(10, 0)));
+
+    mu_sched_sim_start(mk_time(0, 0));
+    TEST_ASSERT_TRUE(mu_sched_every(&tick.thunk, 1000000000LL));
+    TEST_ASSERT_TRUE(mu_sched_at(&once.thunk, mk_time(1800, 500)));
+
+    TEST_ASSERT_EQUAL_size_t(3601, mu_sched_sim_run_until(mk_time(3600, 0)));
+    TEST_ASSERT_EQUAL(3600, tick.call_count);
+    TEST_ASSERT_EQUAL(1, once.call_count);
+    TEST_ASSERT_EQUAL_INT(3600, mu_sched_current_time().seconds);
+
+    // Stops short of deadlines after `end`, then leaves the clock at `end`
+    TEST_ASSERT_EQUAL_size_t(0,
+                             mu_sched_sim_run_until(mk_time(3600, 999999)));
+    TEST_ASSERT_EQUAL_INT(TU(999999), mu_sched_current_time().nanoseconds);
+}
+
+// -----------------------------------------------------------------------------
+// Tests for lazy promotion
+// -----------------------------------------------------------------------------
+
+void test_mu_sched_lazy_burst_bypasses_full_asap_q(void) {
+    order_thunk_t T[MAX_TEST_THUNKS + 3];
+    mu_thunk_t *taken;
+
+    init_scheduler_for_test();
+    order_log_count = 0;
+    mu_sched_set_lazy_promotion(true);
+    for (int i = 0; i < MAX_TEST_THUNKS + 3; i++) {
+        order_thunk_init(&T[i], i);
+    }
+    for (int i = 0; i < MAX_TEST_THUNKS; i++) {
+        TEST_ASSERT_TRUE(mu_sched_now(&T[i].thunk));
+    }
+    // Three due events behind a full asap_q, the soonest scheduled last
+    TEST_ASSERT_TRUE(mu_sched_at(&T[5].thunk, mk_time(0, 20)));
+    TEST_ASSERT_TRUE(mu_sched_at(&T[6].thunk, mk_time(0, 30)));
+    TEST_ASSERT_TRUE(mu_sched_at(&T[4].thunk, mk_time(0, 10)));
+    set_virtual_time(mk_time(0, 30));
+
+    TEST_ASSERT_EQUAL_size_t(MAX_TEST_THUNKS + 2, mu_sched_step_n(6));
+    for (int i = 0; i < MAX_TEST_THUNKS + 2; i++) {
+        TEST_ASSERT_EQUAL_INT(i, order_log[i]);
+    }
+    TEST_ASSERT_TRUE(mu_sched_take_ready(&taken));
+    TEST_ASSERT_EQUAL_PTR(&T[6].thunk, taken);
+    TEST_ASSERT_FALSE(mu_sched_take_ready(&taken));
+
+    TEST_ASSERT_EQUAL_UINT32(0, mu_sched_overload_stats()->deferred);
+    TEST_ASSERT_EQUAL_size_t(MAX_TEST_THUNKS,
+                             mu_sched_overload_stats()->ready_hwm);
+}
+
+void test_mu_sched_lazy_with_edf_compares_deadlines(void) {
+    static mu_sched_edf_entry_t edf_store[MAX_TEST_THUNKS];
+    mu_sched_edf_t edf;
+    order_thunk_t T[3];
+    mu_sched_handle_t handle;
+
+    init_scheduler_for_test();
+    order_log_count = 0;
+    mu_sched_edf_init(&edf, edf_store, MAX_TEST_THUNKS);
+    mu_sched_set_edf_queue(&edf);
+    mu_sched_set_lazy_promotion(true);
+    for (int i = 0; i < 3; i++) {
+        order_thunk_init(&T[i], i);
+    }
+    TEST_ASSERT_TRUE(mu_sched_now_deadline(&T[0].thunk, mk_time(0, 50)));
+    TEST_ASSERT_TRUE(mu_sched_at(&T[1].thunk, mk_time(0, 20)));
+    TEST_ASSERT_TRUE(mu_sched_at(&T[2].thunk, mk_time(0, 80)));
+    // A cancelled event at the head of the store is skipped
+    TEST_ASSERT_TRUE(mu_sched_at_handle(&T[2].thunk, mk_time(0, 5), &handle));
+    TEST_ASSERT_TRUE(mu_sched_cancel(&handle));
+    set_virtual_time(mk_time(0, 100));
+
+    TEST_ASSERT_EQUAL_size_t(3, mu_sched_step_n(4));
+    TEST_ASSERT_EQUAL_INT(1, order_log[0]); // due at 20
+    TEST_ASSERT_EQUAL_INT(0, order_log[1]); // deadline 50
+    TEST_ASSERT_EQUAL_INT(2, order_log[2]); // due at 80
+    TEST_ASSERT_EQUAL_size_t(0, mu_sched_edf_count(&edf));
+}
+
+// -----------------------------------------------------------------------------
+// Tests for coarse clock mode
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    mu_thunk_t thunk;
+    mu_time_abs_t seen;
+    mu_thunk_t *later;
+} clock_probe_thunk_t;
+
+// Lets time pass, then reads it and schedules `later` relative to it
+static void clock_probe_fn(mu_thunk_t *thunk, void *args) {
+    (void)args;
+    clock_probe_thunk_t *probe = (clock_probe_thunk_t *)thunk;
+    set_virtual_time(mk_time(0, 1000));
+    probe->seen = mu_sched_current_time();
+    mu_sched_in(probe->later, TU(100));
+}
+
+static void clock_probe_for_test(clock_probe_thunk_t *probe,
+                                 counting_thunk_t *later) {
+    init_scheduler_for_test();
+    counting_thunk_init(later);
+    probe->later = &later->thunk;
+    mu_thunk_init(&probe->thunk, clock_probe_fn);
+    TEST_ASSERT_TRUE(mu_sched_now(&probe->thunk));
+}
+
+void test_mu_sched_thunks_see_live_clock_by_default(void) {
+    clock_probe_thunk_t probe;
+    counting_thunk_t later;
+    mu_time_abs_t deadline;
+
+    clock_probe_for_test(&probe, &later);
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(TU(1000), probe.seen.nanoseconds);
+    TEST_ASSERT_TRUE(mu_sched_next_deadline(&deadline));
+    TEST_ASSERT_EQUAL_INT(TU(1100), deadline.nanoseconds);
+}
+
+void test_mu_sched_coarse_clock_holds_pass_time(void) {
+    clock_probe_thunk_t probe;
+    counting_thunk_t later;
+    mu_time_abs_t deadline;
+    mu_time_rel_t timeout;
+
+    clock_probe_for_test(&probe, &later);
+    mu_sched_set_coarse_clock(true);
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(0, probe.seen.nanoseconds);
+    TEST_ASSERT_TRUE(mu_sched_next_deadline(&deadline));
+    TEST_ASSERT_EQUAL_INT(TU(100), deadline.nanoseconds);
+#ifdef MU_SCHED_STATS
+    // Statistics refreshed the reading when the thunk finished
+    TEST_ASSERT_EQUAL_INT(TU(1000), mu_sched_current_time().nanoseconds);
+#else
+    TEST_ASSERT_EQUAL_INT(0, mu_sched_current_time().nanoseconds);
+#endif
+
+    // The idle timeout reads the clock afresh: `later` is already due
+    TEST_ASSERT_TRUE(mu_sched_idle_timeout(&timeout));
+    TEST_ASSERT_EQUAL_INT64(0, timeout);
+    TEST_ASSERT_EQUAL_INT(TU(1000), mu_sched_current_time().nanoseconds);
+
+    mu_sched_step();
+    TEST_ASSERT_EQUAL(1, later.call_count);
+}
+
+// -----------------------------------------------------------------------------
+// Tests for batch scheduling
+// -----------------------------------------------------------------------------
+
+void test_mu_sched_at_many_merges_in_order(void) {
+    order_thunk_t T[5];
+
+    init_scheduler_for_test();
+    order_log_count = 0;
+    for (int i = 0; i < 5; i++) {
+        order_thunk_init(&T[i], i);
+    }
+    TEST_ASSERT_TRUE(mu_sched_at(&T[0].thunk, mk_time(0, 20)));
+
+    mu_thunk_t *const thunks[] = {&T[1].thunk, &T[2].thunk, &T[3].thunk};
+    const mu_time_abs_t times[] = {mk_time(0, 30), mk_time(0, 10),
+                                   mk_time(0, 20)};
+    TEST_ASSERT_TRUE(mu_sched_at_many(thunks, times, 3));
+    TEST_ASSERT_TRUE(mu_sched_at_many(thunks, times, 0));
+    // Event queue full: nothing of the batch is taken
+    TEST_ASSERT_FALSE(mu_sched_at_many(thunks, times, 1));
+
+    set_virtual_time(mk_time(0, 30));
+    TEST_ASSERT_EQUAL_size_t(4, mu_sched_step_n(10));
+    TEST_ASSERT_EQUAL_INT(2, order_log[0]); // 10
+    TEST_ASSERT_EQUAL_INT(0, order_log[1]); // 20, scheduled first
+    TEST_ASSERT_EQUAL_INT(3, order_log[2]); // 20
+    TEST_ASSERT_EQUAL_INT(1, order_log[3]); // 30
+}
+
+MU_SCHED_DEFINE(s_merge_sched, 4, 16, 16);
+
+void test_mu_sched_at_many_interleaves_with_pending(void) {
+    order_thunk_t T[10];
+    // ids 0-4 are scheduled one by one, ids 5-9 as one batch
+    static const long offsets_ns[10] = {10, 20, 20, 40, 60,
+                                        70, 20, 30, 10, 50};
+    static const int expected[10] = {0, 8, 1, 2, 6, 7, 3, 9, 4, 5};
+    mu_thunk_t *thunks[5];
+    mu_time_abs_t times[5];
+
+    TEST_ASSERT_TRUE(s_merge_sched_init());
+    mu_sched_set_time_fn_ex(&s_merge_sched, get_virtual_time);
+    set_virtual_time(mk_time(0, 0));
+    order_log_count = 0;
+    for (int i = 0; i < 10; i++) {
+        order_thunk_init(&T[i], i);
+    }
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(mu_sched_at_ex(&s_merge_sched, &T[i].thunk,
+                                        mk_time(0, offsets_ns[i])));
+        thunks[i] = &T[5 + i].thunk;
+        times[i] = mk_time(0, offsets_ns[5 + i]);
+    }
+    TEST_ASSERT_TRUE(mu_sched_at_many_ex(&s_merge_sched, thunks, times, 5));
+
+    set_virtual_time(mk_time(1, 0));
+    TEST_ASSERT_EQUAL_size_t(10, mu_sched_step_n_ex(&s_merge_sched, 16));
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, order_log, 10);
+}
+
+void test_mu_sched_at_many_is_all_or_nothing(void) {
+    counting_thunk_t A;
+    mu_thunk_t *thunks[MAX_WHEEL_TEST_EVENTS + 1];
+    mu_time_abs_t times[MAX_WHEEL_TEST_EVENTS + 1];
+    mu_time_abs_t deadline;
+
+    init_wheel_scheduler_for_test(1000);
+    counting_thunk_init(&A);
+    for (int i = 0; i <= MAX_WHEEL_TEST_EVENTS; i++) {
+        thunks[i] = &A.thunk;
+        times[i] = mk_time(0, 1000 * (MAX_WHEEL_TEST_EVENTS - i));
+    }
+    // One more than the pool holds: every reserved wrapper is returned
+    TEST_ASSERT_FALSE(
+        mu_sched_at_many(thunks, times, MAX_WHEEL_TEST_EVENTS + 1));
+    TEST_ASSERT_FALSE(mu_sched_next_deadline(&deadline));
+    thunks[1] = NULL;
+    TEST_ASSERT_FALSE(mu_sched_at_many(thunks, times, 2));
+    thunks[1] = &A.thunk;
+
+    TEST_ASSERT_TRUE(mu_sched_at_many(thunks, times, MAX_WHEEL_TEST_EVENTS));
+    TEST_ASSERT_TRUE(mu_sched_next_deadline(&deadline));
+    TEST_ASSERT_EQUAL_INT(TU(1000), deadline.nanoseconds);
+    set_virtual_time(mk_time(0, 1000 * MAX_WHEEL_TEST_EVENTS));
+    TEST_ASSERT_EQUAL_size_t(MAX_WHEEL_TEST_EVENTS,
+                             mu_sched_step_n(MAX_WHEEL_TEST_EVENTS + 1));
+    TEST_ASSERT_EQUAL(MAX_WHEEL_TEST_EVENTS, A.call_count);
+}
+
+void test_mu_sched_now_many_is_all_or_nothing(void) {
+    order_thunk_t T[MAX_TEST_THUNKS + 1];
+    mu_thunk_t *thunks[MAX_TEST_THUNKS];
+
+    init_scheduler_for_test();
+    order_log_count = 0;
+    for (int i = 0; i <= MAX_TEST_THUNKS; i++) {
+        order_thunk_init(&T[i], i);
+    }
+    for (int i = 0; i < MAX_TEST_THUNKS; i++) {
+        thunks[i] = &T[i + 1].thunk;
+    }
+    TEST_ASSERT_TRUE(mu_sched_now(&T[0].thunk));
+    TEST_ASSERT_FALSE(mu_sched_now_many(thunks, MAX_TEST_THUNKS));
+    TEST_ASSERT_EQUAL_UINT32(1, mu_sched_overload_stats()->rejected);
+    TEST_ASSERT_TRUE(mu_sched_now_many(thunks, MAX_TEST_THUNKS - 1));
+
+    TEST_ASSERT_EQUAL_size_t(MAX_TEST_THUNKS, mu_sched_step_n(10));
+    for (int i = 0; i < MAX_TEST_THUNKS; i++) {
+        TEST_ASSERT_EQUAL_INT(i, order_log[i]);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Tests for thunk arguments
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    mu_thunk_t thunk;
+    void *seen[MAX_TEST_THUNKS];
+    int call_count;
+} args_thunk_t;
+
+static void args_thunk_fn(mu_thunk_t *thunk, void *args) {
+    args_thunk_t *args_thunk = (args_thunk_t *)thunk;
+    if (args_thunk->call_count < MAX_TEST_THUNKS) {
+        args_thunk->seen[args_thunk->call_count] = args;
+    }
+    args_thunk->call_count++;
+}
+
+static void args_thunk_init(args_thunk_t *args_thunk) {
+    args_thunk->call_count = 0;
+    mu_thunk_init(&args_thunk->thunk, args_thunk_fn);
+}
+
+void test_mu_sched_now_and_at_pass_args(void) {
+    args_thunk_t A;
+    int x, y;
+    mu_thunk_t *taken;
+    void *args;
+
+    init_scheduler_for_test();
+    args_thunk_init(&A);
+    TEST_ASSERT_FALSE(mu_sched_now_args(NULL, &x));
+    TEST_ASSERT_TRUE(mu_sched_at_args(&A.thunk, mk_time(0, 10), &y));
+    TEST_ASSERT_TRUE(mu_sched_now_args(&A.thunk, &x));
+    TEST_ASSERT_TRUE(mu_sched_now(&A.thunk));
+
+    set_virtual_time(mk_time(0, 10));
+    TEST_ASSERT_EQUAL_size_t(2, mu_sched_step_n(2));
+    TEST_ASSERT_EQUAL_PTR(&x, A.seen[0]);
+    TEST_ASSERT_NULL(A.seen[1]);
+
+    // The due event promoted with its argument
+    TEST_ASSERT_TRUE(mu_sched_take_ready_args(&taken, &args));
+    TEST_ASSERT_EQUAL_PTR(&A.thunk, taken);
+    TEST_ASSERT_EQUAL_PTR(&y, args);
+    mu_sched_run_args(taken, args);
+    TEST_ASSERT_EQUAL_PTR(&y, A.seen[2]);
+
+    // Every wrapper went back to the pool
+    for (int i = 0; i < MAX_TEST_THUNKS; i++) {
+        TEST_ASSERT_TRUE(mu_sched_now_args(&A.thunk, &x));
+    }
+    TEST_ASSERT_FALSE(mu_sched_now_args(&A.thunk, &x));
+}
+
+void test_mu_sched_from_isr_args_uses_remote_queue(void) {
+    args_thunk_t A;
+    uint8_t dma_buffer[16];
+
+    init_scheduler_for_test();
+    args_thunk_init(&A);
+    TEST_ASSERT_FALSE(mu_sched_from_isr_args(&A.thunk, dma_buffer));
+    attach_remote_queue_for_test();
+    TEST_ASSERT_TRUE(mu_sched_from_isr_args(&A.thunk, dma_buffer));
+    TEST_ASSERT_TRUE(mu_sched_post_remote(&A.thunk));
+
+    TEST_ASSERT_EQUAL_size_t(2, mu_sched_step_n(4));
+    TEST_ASSERT_EQUAL_PTR(dma_buffer, A.seen[0]);
+    TEST_ASSERT_NULL(A.seen[1]);
+    mu_sched_set_remote_queue(NULL);
+}
+
+void test_mu_sched_from_isr_args_runs_after_ready_thunks(void) {
+    args_thunk_t A, B, C;
+    int x;
+
+    init_scheduler_for_test();
+    args_thunk_init(&A);
+    args_thunk_init(&B);
+    args_thunk_init(&C);
+    attach_remote_queue_for_test();
+
+    TEST_ASSERT_TRUE(mu_sched_now(&A.thunk));
+    TEST_ASSERT_TRUE(mu_sched_from_isr_args(&B.thunk, &x));
+    TEST_ASSERT_TRUE(mu_sched_from_isr(&C.thunk));
+
+    // The later plain ISR post jumps ahead; the ready thunk keeps its place
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(1, C.call_count);
+    TEST_ASSERT_EQUAL_INT(0, A.call_count + B.call_count);
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(1, A.call_count);
+    TEST_ASSERT_EQUAL_INT(0, B.call_count);
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_PTR(&x, B.seen[0]);
+    mu_sched_set_remote_queue(NULL);
+}
+
+// -----------------------------------------------------------------------------
+// Tests for run-time budgets
+// -----------------------------------------------------------------------------
+
+// Works in 1 ns chunks of virtual time until told to yield.
+typedef struct {
+    mu_thunk_t thunk;
+    int chunks;     // chunks to do in the next run, 0 for "until yield"
+    int chunks_run; // chunks done in the last run
+} chunked_thunk_t;
+
+static void chunked_thunk_fn(mu_thunk_t *thunk, void *args) {
+    chunked_thunk_t *chunked = (chunked_thunk_t *)thunk;
+    (void)args;
+    chunked->chunks_run = 0;
+    while (chunked->chunks ? chunked->chunks_run < chunked->chunks
+                           : !mu_sched_should_yield()) {
+        set_virtual_time(mu_time_offset(get_virtual_time(), 1));
+        chunked->chunks_run++;
+    }
+}
+
+static const mu_thunk_t *overrun_thunk;
+static mu_time_rel_t overrun_runtime;
+static int overrun_calls;
+
+static void record_overrun(const mu_thunk_t *thunk, mu_time_rel_t runtime,
+                           mu_time_rel_t budget) {
+    (void)budget;
+    overrun_thunk = thunk;
+    overrun_runtime = runtime;
+    overrun_calls++;
+}
+
+void test_mu_sched_budget_overruns_are_reported(void) {
+    mu_sched_budget_t table[4];
+    chunked_thunk_t A;
+
+    init_scheduler_for_test();
+    mu_thunk_init(&A.thunk, chunked_thunk_fn);
+    overrun_calls = 0;
+    TEST_ASSERT_TRUE(mu_sched_set_budget_table(table, 4));
+    TEST_ASSERT_TRUE(mu_sched_set_budget(&A.thunk, 5));
+    mu_sched_set_overrun_fn(record_overrun);
+    TEST_ASSERT_FALSE(mu_sched_should_yield()); // no thunk running
+
+    // Polling should_yield() keeps the thunk within its budget
+    A.chunks = 0;
+    mu_sched_now(&A.thunk);
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(5, A.chunks_run);
+    TEST_ASSERT_EQUAL_INT(0, overrun_calls);
+
+    // Ignoring it is an overrun
+    A.chunks = 8;
+    mu_sched_now(&A.thunk);
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(1, overrun_calls);
+    TEST_ASSERT_EQUAL_PTR(&A.thunk, overrun_thunk);
+    TEST_ASSERT_EQUAL_INT64(8, overrun_runtime);
+
+    const mu_sched_budget_t *budget = mu_sched_budget(&A.thunk);
+    TEST_ASSERT_NOT_NULL(budget);
+    TEST_ASSERT_EQUAL_INT64(5, budget->budget);
+    TEST_ASSERT_EQUAL_INT64(8, budget->max_runtime);
+    TEST_ASSERT_EQUAL_UINT32(1, budget->overruns);
+}
+
+void test_mu_sched_unbudgeted_thunks_are_not_timed(void) {
+    mu_sched_budget_t table[2];
+    chunked_thunk_t A, B, C;
+
+    init_scheduler_for_test();
+    mu_thunk_init(&A.thunk, chunked_thunk_fn);
+    mu_thunk_init(&B.thunk, chunked_thunk_fn);
+    mu_thunk_init(&C.thunk, chunked_thunk_fn);
+    overrun_calls = 0;
+    mu_sched_set_overrun_fn(record_overrun);
+
+    TEST_ASSERT_FALSE(mu_sched_set_budget(&A.thunk, 5)); // no table yet
+    TEST_ASSERT_FALSE(mu_sched_set_budget_table(table, 3));
+    TEST_ASSERT_TRUE(mu_sched_set_budget_table(table, 2));
+    TEST_ASSERT_FALSE(mu_sched_set_budget(&A.thunk, 0));
+    TEST_ASSERT_FALSE(mu_sched_set_budget(NULL, 5));
+    TEST_ASSERT_TRUE(mu_sched_set_budget(&A.thunk, 5));
+    TEST_ASSERT_TRUE(mu_sched_set_budget(&B.thunk, 5));
+    TEST_ASSERT_FALSE(mu_sched_set_budget(&C.thunk, 5)); // table full
+    TEST_ASSERT_NULL(mu_sched_budget(&C.thunk));
+
+    // A thunk without a budget never has to yield, and never overruns
+    C.chunks = 100;
+    mu_sched_now(&C.thunk);
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(0, overrun_calls);
+
+    // Detaching forgets all budgets
+    TEST_ASSERT_TRUE(mu_sched_set_budget_table(NULL, 0));
+    TEST_ASSERT_NULL(mu_sched_budget(&A.thunk));
+    A.chunks = 8;
+    mu_sched_now(&A.thunk);
+    mu_sched_step();
+    TEST_ASSERT_EQUAL_INT(0, overrun_calls);
+}
+
+// -----------------------------------------------------------------------------
+// Tests for once nodes
+// -----------------------------------------------------------------------------
+
+void test_mu_sched_now_once_skips_queued_thunks(void) {
+    counting_thunk_t A;
+    mu_sched_once_t once;
+
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+    TEST_ASSERT_NULL(mu_sched_once_init(&once, NULL));
+    TEST_ASSERT_EQUAL_PTR(&once, mu_sched_once_init(&once, &A.thunk));
+    TEST_ASSERT_FALSE(mu_sched_now_once(NULL));
+
+    TEST_ASSERT_TRUE(mu_sched_now_once(&once));
+    TEST_ASSERT_TRUE(mu_sched_now_once(&once));
+    TEST_ASSERT_TRUE(mu_sched_from_isr_once(&once));
+    TEST_ASSERT_EQUAL_size_t(1, mu_sched_step_n(4));
+    TEST_ASSERT_EQUAL_INT(1, A.call_count);
+
+    // Once taken, the node can be queued again, from either side
+    TEST_ASSERT_TRUE(mu_sched_from_isr_once(&once));
+    TEST_ASSERT_TRUE(mu_sched_now_once(&once));
+    TEST_ASSERT_TRUE(mu_sched_from_isr_once(&once));
+    TEST_ASSERT_EQUAL_size_t(1, mu_sched_step_n(4));
+    TEST_ASSERT_EQUAL_INT(2, A.call_count);
+}
+
+void test_mu_sched_now_once_recovers_from_full_queue(void) {
+    counting_thunk_t A, B;
+    mu_sched_once_t once;
+
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+    counting_thunk_init(&B);
+    mu_sched_once_init(&once, &A.thunk);
+    for (int i = 0; i < MAX_TEST_THUNKS; i++) {
+        TEST_ASSERT_TRUE(mu_sched_now(&B.thunk));
+    }
+    TEST_ASSERT_FALSE(mu_sched_now_once(&once));
+
+    // The failed post did not leave the node marked as queued
+    TEST_ASSERT_EQUAL_size_t(MAX_TEST_THUNKS, mu_sched_step_n(MAX_TEST_THUNKS));
+    TEST_ASSERT_TRUE(mu_sched_now_once(&once));
+    TEST_ASSERT_EQUAL_size_t(1, mu_sched_step_n(2));
+    TEST_ASSERT_EQUAL_INT(1, A.call_count);
+
+    // Neither does an eviction
+    mu_sched_set_overload_policy(MU_SCHED_OVERLOAD_DROP_OLDEST);
+    TEST_ASSERT_TRUE(mu_sched_now_once(&once));
+    for (int i = 0; i < MAX_TEST_THUNKS; i++) {
+        TEST_ASSERT_TRUE(mu_sched_now(&B.thunk));
+    }
+    TEST_ASSERT_EQUAL_size_t(MAX_TEST_THUNKS, mu_sched_step_n(MAX_TEST_THUNKS));
+    TEST_ASSERT_EQUAL_INT(1, A.call_count);
+    TEST_ASSERT_TRUE(mu_sched_now_once(&once));
+    TEST_ASSERT_EQUAL_size_t(1, mu_sched_step_n(2));
+    TEST_ASSERT_EQUAL_INT(2, A.call_count);
+}
+
+// -----------------------------------------------------------------------------
+// Tests for compile-time sized schedulers
+// -----------------------------------------------------------------------------
+
+MU_SCHED_DEFINE(s_static_sched, 8, 3, 3);
+
+void test_mu_sched_define_runs_thunks(void) {
+    counting_thunk_t A;
+
+    counting_thunk_init(&A);
+    TEST_ASSERT_FALSE(mu_sched_now_ex(&s_static_sched, &A.thunk));
+    TEST_ASSERT_TRUE(s_static_sched_init());
+    mu_sched_set_time_fn_ex(&s_static_sched, get_virtual_time);
+    set_virtual_time(mk_time(0, 0));
+
+    TEST_ASSERT_TRUE(mu_sched_now_ex(&s_static_sched, &A.thunk));
+    TEST_ASSERT_TRUE(mu_sched_from_isr_ex(&s_static_sched, &A.thunk));
+    TEST_ASSERT_TRUE(mu_sched_at_ex(&s_static_sched, &A.thunk, mk_time(0, 5)));
+    TEST_ASSERT_EQUAL_size_t(2, mu_sched_step_n_ex(&s_static_sched, 4));
+    set_virtual_time(mk_time(0, 5));
+    TEST_ASSERT_EQUAL_size_t(1, mu_sched_step_n_ex(&s_static_sched, 4));
+    TEST_ASSERT_EQUAL_INT(3, A.call_count);
+}
+
+void test_mu_sched_define_sizes_its_stores(void) {
+    counting_thunk_t A;
+
+    counting_thunk_init(&A);
+    TEST_ASSERT_TRUE(s_static_sched_init());
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(mu_sched_now_ex(&s_static_sched, &A.thunk));
+        TEST_ASSERT_TRUE(
+            mu_sched_in_ex(&s_static_sched, &A.thunk, 1000000000LL));
+    }
+    TEST_ASSERT_FALSE(mu_sched_now_ex(&s_static_sched, &A.thunk));
+    TEST_ASSERT_FALSE(mu_sched_in_ex(&s_static_sched, &A.thunk, 1000000000LL));
+    TEST_ASSERT_TRUE(MU_SCHED_IS_POW2(64));
+    TEST_ASSERT_FALSE(MU_SCHED_IS_POW2(48));
+    TEST_ASSERT_FALSE(MU_SCHED_IS_POW2(0));
+}
+
+// -----------------------------------------------------------------------------
+// Tests for snapshots
+// -----------------------------------------------------------------------------
+
+void test_mu_sched_snapshot_reports_queues(void) {
+    counting_thunk_t A, B;
+    mu_sched_handle_t handle;
+    mu_sched_snapshot_t snap;
+    mu_sched_pending_t pending[2];
+
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+    counting_thunk_init(&B);
+    TEST_ASSERT_FALSE(mu_sched_snapshot(NULL, NULL, 0));
+    TEST_ASSERT_FALSE(mu_sched_snapshot(&snap, NULL, 1));
+
+    TEST_ASSERT_TRUE(mu_sched_from_isr(&A.thunk));
+    TEST_ASSERT_TRUE(mu_sched_from_isr(&A.thunk));
+    TEST_ASSERT_TRUE(mu_sched_now(&A.thunk));
+    TEST_ASSERT_TRUE(mu_sched_at(&A.thunk, mk_time(0, 30)));
+    TEST_ASSERT_TRUE(mu_sched_at_handle(&B.thunk, mk_time(0, 10), &handle));
+    TEST_ASSERT_TRUE(mu_sched_at(&B.thunk, mk_time(0, 20)));
+    TEST_ASSERT_TRUE(mu_sched_cancel(&handle)); // leaves a tombstone
+
+    TEST_ASSERT_TRUE(mu_sched_snapshot(&snap, pending, 2));
+    TEST_ASSERT_EQUAL_size_t(2, snap.isr_count);
+    TEST_ASSERT_EQUAL_size_t(1, snap.ready_count);
+    TEST_ASSERT_EQUAL_size_t(MAX_TEST_THUNKS, snap.ready_capacity);
+    TEST_ASSERT_EQUAL_size_t(3, snap.event_count);
+    TEST_ASSERT_EQUAL_size_t(MAX_TEST_THUNKS, snap.event_capacity);
+    TEST_ASSERT_EQUAL_size_t(3, snap.pool_in_use);
+    TEST_ASSERT_EQUAL_size_t(3, snap.overload.pool_hwm);
+    TEST_ASSERT_EQUAL_size_t(2, snap.overload.isr_hwm);
+    TEST_ASSERT_FALSE(snap.remote_pending);
+    TEST_ASSERT_EQUAL_size_t(2, snap.pending_count);
+    TEST_ASSERT_EQUAL_PTR(&B.thunk, pending[0].thunk);
+    TEST_ASSERT_EQUAL_INT64(
+        0, mu_time_difference(pending[0].timestamp, mk_time(0, 20)));
+    TEST_ASSERT_EQUAL_PTR(&A.thunk, pending[1].thunk);
+
+    // Nothing was taken or promoted
+    TEST_ASSERT_EQUAL_size_t(3, mu_sched_step_n(8));
+    TEST_ASSERT_EQUAL_INT(3, A.call_count);
+    TEST_ASSERT_TRUE(mu_sched_snapshot(&snap, NULL, 0));
+    TEST_ASSERT_EQUAL_size_t(0, snap.isr_count);
+    TEST_ASSERT_EQUAL_size_t(2, snap.overload.isr_hwm);
+    set_virtual_time(mk_time(1, 0));
+    mu_sched_step_n(8);
+    TEST_ASSERT_TRUE(mu_sched_snapshot(&snap, pending, 2));
+    TEST_ASSERT_EQUAL_size_t(0, snap.pool_in_use);
+    TEST_ASSERT_EQUAL_size_t(0, snap.pending_count);
+}
+
+void test_mu_sched_snapshot_counts_prio_queues(void) {
+    counting_thunk_t A;
+    mu_pqueue_t prio_q;
+    void *prio_store[4];
+    mu_sched_snapshot_t snap;
+
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+    mu_pqueue_init(&prio_q, prio_store, 4);
+    TEST_ASSERT_TRUE(mu_sched_set_prio_queue(0, &prio_q));
+    TEST_ASSERT_TRUE(mu_sched_now(&A.thunk));
+    TEST_ASSERT_TRUE(mu_sched_now_prio(&A.thunk, 0));
+    TEST_ASSERT_TRUE(mu_sched_now_prio(&A.thunk, 0));
+
+    // Attached levels count toward both the fill and the capacity
+    TEST_ASSERT_TRUE(mu_sched_snapshot(&snap, NULL, 0));
+    TEST_ASSERT_EQUAL_size_t(3, snap.ready_count);
+    TEST_ASSERT_EQUAL_size_t(MAX_TEST_THUNKS + 4, snap.ready_capacity);
+    TEST_ASSERT_EQUAL_size_t(3, mu_sched_step_n(4));
+}
+
+void test_mu_sched_snapshot_isr_count_ignores_failed_posts(void) {
+    counting_thunk_t A;
+    mu_sched_once_t once;
+    mu_sched_snapshot_t snap;
+    size_t accepted = 0;
+
+    init_scheduler_for_test();
+    counting_thunk_init(&A);
+    mu_sched_once_init(&once, &A.thunk);
+
+    while (mu_sched_from_isr(&A.thunk)) {
+        accepted++;
+    }
+    // Rejected posts, plain or once, leave the depth alone
+    TEST_ASSERT_FALSE(mu_sched_from_isr(&A.thunk));
+    TEST_ASSERT_FALSE(mu_sched_from_isr_once(&once));
+    TEST_ASSERT_TRUE(mu_sched_snapshot(&snap, NULL, 0));
+    TEST_ASSERT_EQUAL_size_t(accepted, snap.isr_count);
+
+    mu_sched_step();
+    TEST_ASSERT_TRUE(mu_sched_snapshot(&snap, NULL, 0));
+    TEST_ASSERT_EQUAL_size_t(accepted - 1, snap.isr_count);
+    TEST_ASSERT_EQUAL_size_t(accepted, snap.overload.isr_hwm);
+    TEST_ASSERT_EQUAL_size_t(accepted - 1, mu_sched_step_n(2 * accepted));
+    TEST_ASSERT_TRUE(mu_sched_snapshot(&snap, NULL, 0));
+    TEST_ASSERT_EQUAL_size_t(0, snap.isr_count);
+}
+
+static void check_snapshot_lists_soonest_events(void) {
+    order_thunk_t T[6];
+    mu_sched_snapshot_t snap;
+    mu_sched_pending_t pending[3];
+    static const long offsets_ns[6] = {500, 40, 300, 40, 9000, 100};
+
+    for (int i = 0; i < 6; i++) {
+        order_thunk_init(&T[i], i);
+        TEST_ASSERT_TRUE(mu_sched_at(&T[i].thunk, mk_time(1, offsets_ns[i])));
+    }
+    TEST_ASSERT_TRUE(mu_sched_every(&T[0].thunk, TU(1000000)));
+
+    TEST_ASSERT_TRUE(mu_sched_snapshot(&snap, pending, 3));
+    TEST_ASSERT_EQUAL_size_t(7, snap.event_count);
+    TEST_ASSERT_EQUAL_size_t(3, snap.pending_count);
+    TEST_ASSERT_EQUAL_INT64(
+        0, mu_time_difference(pending[0].timestamp, mk_time(0, 1000000)));
+    TEST_ASSERT_EQUAL_INT64(TU(1000000), pending[0].period);
+    TEST_ASSERT_EQUAL_INT64(
+        0, mu_time_difference(pending[1].timestamp, mk_time(1, 40)));
+    TEST_ASSERT_EQUAL_INT64(
+        0, mu_time_difference(pending[2].timestamp, mk_time(1, 40)));
+    TEST_ASSERT_EQUAL_INT64(0, pending[1].period);
+}
+
+void test_mu_sched_snapshot_lists_soonest_events(void) {
+    init_heap_scheduler_for_test();
+    check_snapshot_lists_soonest_events();
+    init_wheel_scheduler_for_test(1000);
+    check_snapshot_lists_soonest_events();
+}
+
+// -----------------------------------------------------------------------------
+// Tests for tick timestamps
+// -----------------------------------------------------------------------------
+
+void test_mu_sched_tick_compare_is_wrap_safe(void) {
+    const mu_event_tick_t max = (mu_event_tick_t)-1;
+
+    TEST_ASSERT_TRUE(mu_event_tick_is_before(1, 2));
+    TEST_ASSERT_FALSE(mu_event_tick_is_before(2, 1));
+    TEST_ASSERT_FALSE(mu_event_tick_is_before(5, 5));
+    // Across the wrap point: max - 1 comes before 3
+    TEST_ASSERT_TRUE(mu_event_tick_is_before(max - 1, 3));
+    TEST_ASSERT_FALSE(mu_event_tick_is_before(3, max - 1));
+    TEST_ASSERT_EQUAL_INT64(5 * MU_SCHED_TICK_NS,
+                            mu_event_tick_difference(3, max - 1));
+    TEST_ASSERT_EQUAL_INT64(-5 * MU_SCHED_TICK_NS,
+                            mu_event_tick_difference(max - 1, 3));
+    // Truncates to whole ticks
+    TEST_ASSERT_EQUAL_UINT64(
+        2 * 1000000000ull / MU_SCHED_TICK_NS + 1,
+        mu_event_tick_of((mu_time_abs_t){
+            .seconds = 2, .nanoseconds = MU_SCHED_TICK_NS * 3 / 2}));
+}
+
 // *****************************************************************************
 // Test driver
 
@@ -421,6 +2899,93 @@ int main(void) {
     RUN_TEST(test_mu_sched_current_thunk_reports_self);
     RUN_TEST(test_mu_sched_current_time_returns_overridden_time);
     RUN_TEST(test_mu_sched_delete_thunk_events_removes_matching);
+    RUN_TEST(test_mu_sched_step_n_isr_first_and_budget);
+    RUN_TEST(test_mu_sched_step_n_reads_clock_once);
+    RUN_TEST(test_mu_sched_step_n_idle_only_when_nothing_ran);
+    RUN_TEST(test_mu_sched_next_deadline_reports_earliest);
+    RUN_TEST(test_mu_sched_wheel_next_deadline_reports_earliest);
+    RUN_TEST(test_mu_sched_idle_timeout);
+    RUN_TEST(test_mu_sched_cancel_pending_event);
+    RUN_TEST(test_mu_sched_cancel_after_run_returns_false);
+    RUN_TEST(test_mu_sched_cancel_stale_handle_is_ignored);
+    RUN_TEST(test_mu_sched_wheel_cancel_frees_immediately);
+    RUN_TEST(test_mu_sched_every_keeps_phase_and_skips_missed);
+    RUN_TEST(test_mu_sched_wheel_every_keeps_phase_and_skips_missed);
+    RUN_TEST(test_mu_sched_intrusive_events_without_pool);
+    RUN_TEST(test_mu_sched_wheel_intrusive_events_without_pool);
+#ifdef MU_SCHED_STATS
+    RUN_TEST(test_mu_sched_stats_lateness_and_runtime);
+    RUN_TEST(test_mu_sched_stats_untracked_when_table_full);
+#endif
+    RUN_TEST(test_mu_sched_trace_ring_wraps_and_writes_oldest_first);
+    RUN_TEST(test_mu_sched_trace_count_survives_head_wrap);
+#ifdef MU_SCHED_TRACE
+    RUN_TEST(test_mu_sched_trace_records_scheduler_events);
+#endif
+    RUN_TEST(test_mu_sched_mpsc_put_get_full_and_wrap);
+    RUN_TEST(test_mu_sched_post_remote_runs_after_isr);
+    RUN_TEST(test_mu_sched_post_remote_drains_with_pool_empty);
+    RUN_TEST(test_mu_sched_post_remote_drains_in_batches);
+    RUN_TEST(test_mu_sched_post_remote_from_many_threads);
+    RUN_TEST(test_mu_sched_exec_idle_worker_steals);
+    RUN_TEST(test_mu_sched_exec_reposted_thunk_never_overlaps);
+    RUN_TEST(test_mu_sched_exec_post_and_timers);
+    RUN_TEST(test_mu_sched_instances_are_independent);
+    RUN_TEST(test_mu_sched_uninitialized_instance_is_rejected);
+    RUN_TEST(test_mu_sched_wheel_respects_delay);
+    RUN_TEST(test_mu_sched_wheel_sub_tick_timestamps);
+    RUN_TEST(test_mu_sched_wheel_earliest_first);
+    RUN_TEST(test_mu_sched_wheel_tied_fifo_across_levels);
+    RUN_TEST(test_mu_sched_wheel_delete_thunk_events);
+    RUN_TEST(test_mu_sched_heap_earliest_first_ties_fifo);
+    RUN_TEST(test_mu_sched_heap_cancel_and_delete);
+    RUN_TEST(test_mu_sched_heap_every_keeps_phase_and_skips_missed);
+    RUN_TEST(test_mu_sched_keyed_heap_earliest_first_ties_fifo);
+    RUN_TEST(test_mu_sched_keyed_heap_cancel_and_delete);
+
+    RUN_TEST(test_mu_sched_edf_runs_most_urgent_first);
+    RUN_TEST(test_mu_sched_edf_full_and_detach);
+
+    RUN_TEST(test_mu_sched_prio_highest_level_first);
+
+    RUN_TEST(test_mu_sched_overload_defer_keeps_due_events);
+    RUN_TEST(test_mu_sched_overload_drop_newest);
+    RUN_TEST(test_mu_sched_overload_drop_oldest);
+
+    RUN_TEST(test_mu_sched_coro_awaits_delay_yield_and_condition);
+
+    RUN_TEST(test_mu_sched_signal_wakes_waiters_in_order);
+    RUN_TEST(test_mu_sched_signal_raise_from_isr_coalesces);
+    RUN_TEST(test_mu_sched_coro_awaits_signal);
+
+    RUN_TEST(test_mu_sched_in_slack_joins_pending_event);
+    RUN_TEST(test_mu_sched_in_slack_aligns_to_power_of_two);
+
+    RUN_TEST(test_mu_sched_sim_step_jumps_to_next_deadline);
+    RUN_TEST(test_mu_sched_sim_run_until_covers_an_hour);
+
+    RUN_TEST(test_mu_sched_lazy_burst_bypasses_full_asap_q);
+    RUN_TEST(test_mu_sched_lazy_with_edf_compares_deadlines);
+    RUN_TEST(test_mu_sched_thunks_see_live_clock_by_default);
+    RUN_TEST(test_mu_sched_coarse_clock_holds_pass_time);
+    RUN_TEST(test_mu_sched_at_many_merges_in_order);
+    RUN_TEST(test_mu_sched_at_many_interleaves_with_pending);
+    RUN_TEST(test_mu_sched_at_many_is_all_or_nothing);
+    RUN_TEST(test_mu_sched_now_many_is_all_or_nothing);
+    RUN_TEST(test_mu_sched_now_and_at_pass_args);
+    RUN_TEST(test_mu_sched_from_isr_args_uses_remote_queue);
+    RUN_TEST(test_mu_sched_from_isr_args_runs_after_ready_thunks);
+    RUN_TEST(test_mu_sched_budget_overruns_are_reported);
+    RUN_TEST(test_mu_sched_unbudgeted_thunks_are_not_timed);
+    RUN_TEST(test_mu_sched_now_once_skips_queued_thunks);
+    RUN_TEST(test_mu_sched_now_once_recovers_from_full_queue);
+    RUN_TEST(test_mu_sched_define_runs_thunks);
+    RUN_TEST(test_mu_sched_define_sizes_its_stores);
+    RUN_TEST(test_mu_sched_snapshot_reports_queues);
+    RUN_TEST(test_mu_sched_snapshot_counts_prio_queues);
+    RUN_TEST(test_mu_sched_snapshot_isr_count_ignores_failed_posts);
+    RUN_TEST(test_mu_sched_snapshot_lists_soonest_events);
+    RUN_TEST(test_mu_sched_tick_compare_is_wrap_safe);
 
     return UNITY_END();
 }
\ No newline at end of file
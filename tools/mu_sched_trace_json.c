@@ -0,0 +1,200 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file mu_sched_trace_json.c
+ * @brief Host tool: converts a serialized mu_sched trace to Chrome trace JSON.
+ *
+ * Usage: mu_sched_trace_json [trace.bin] > trace.json
+ *
+ * Reads the output of mu_sched_trace_write() (from a file or stdin) and
+ * writes a JSON document that chrome://tracing and https://ui.perfetto.dev
+ * can open.  Thunk runs become duration slices named after the thunk address;
+ * all other records become instant events.  Each record context (the
+ * scheduler, interrupts, other threads, or a caller-defined value) gets its
+ * own track.
+ *
+ * Traces from 32- and 64-bit targets of either byte order are accepted.  The
+ * 32-bit timestamps are unwrapped from the signed difference between
+ * consecutive records, on the assumption that they are less than half a clock
+ * wrap apart.  A writer claims its slot before it reads the clock, so a record
+ * may carry a stamp slightly older than its predecessor's; such a record is
+ * placed slightly earlier, not a whole wrap later.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_sched_trace.h"
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private function prototypes
+
+static uint64_t get_uint(const unsigned char *p, size_t size, bool swap);
+static const char *type_name(unsigned type);
+static const char *context_name(unsigned context);
+
+// *****************************************************************************
+// Public function implementations
+
+int main(int argc, char **argv) {
+    FILE *in = stdin;
+    unsigned char buf[sizeof(mu_sched_trace_header_t)];
+
+    if (argc > 2) {
+        fprintf(stderr, "usage: %s [trace.bin]\n", argv[0]);
+        return 2;
+    }
+    if (argc == 2 && (in = fopen(argv[1], "rb")) == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    if (fread(buf, sizeof(buf), 1, in) != 1) {
+        fprintf(stderr, "truncated header\n");
+        return 1;
+    }
+    bool swap = false;
+    uint32_t magic = (uint32_t)get_uint(buf, 4, false);
+    if (magic != MU_SCHED_TRACE_MAGIC) {
+        swap = true;
+        if ((uint32_t)get_uint(buf, 4, true) != MU_SCHED_TRACE_MAGIC) {
+            fprintf(stderr, "not a mu_sched trace\n");
+            return 1;
+        }
+    }
+    unsigned version = (unsigned)get_uint(buf + 4, 2, swap);
+    size_t record_size = (size_t)get_uint(buf + 6, 2, swap);
+    uint32_t ticks_per_second = (uint32_t)get_uint(buf + 8, 4, swap);
+    uint32_t count = (uint32_t)get_uint(buf + 12, 4, swap);
+    if (version != MU_SCHED_TRACE_VERSION ||
+        (record_size != 12 && record_size != 16) || ticks_per_second == 0) {
+        fprintf(stderr, "unsupported trace format\n");
+        return 1;
+    }
+
+    printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    int64_t ticks = 0; // unwrapped time of the previous record
+    uint32_t prev = 0;
+    bool first = true;
+    bool named[256] = {false};
+    for (uint32_t i = 0; i < count; i++) {
+        unsigned char rec[16];
+        if (fread(rec, record_size, 1, in) != 1) {
+            fprintf(stderr, "truncated after %" PRIu32 " records\n", i);
+            break;
+        }
+        uint32_t stamp = (uint32_t)get_uint(rec, 4, swap);
+        uint32_t info = (uint32_t)get_uint(rec + 4, 4, swap);
+        uint64_t thunk = get_uint(rec + 8, record_size - 8, swap);
+
+        ticks = i == 0 ? (int64_t)stamp : ticks + (int32_t)(stamp - prev);
+        prev = stamp;
+        double us = (double)ticks * 1e6 / ticks_per_second;
+
+        unsigned type = info & 0xffU;
+        unsigned context = (info >> 8) & 0xffU;
+        if (!named[context]) {
+            // Metadata record naming the context's track
+            printf("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                   "\"tid\":%u,\"args\":{\"name\":\"%s %u\"}}",
+                   first ? "" : ",\n", context + 1, context_name(context),
+                   context);
+            named[context] = true;
+            first = false;
+        }
+        const char *ph = type == MU_SCHED_TRACE_RUN_START ? "B"
+                         : type == MU_SCHED_TRACE_RUN_END ? "E"
+                                                          : "i";
+        printf("%s{\"name\":\"%s 0x%" PRIx64 "\",\"cat\":\"%s\",\"ph\":\"%s\","
+               "\"ts\":%.3f,\"pid\":1,\"tid\":%u%s}",
+               first ? "" : ",\n", type_name(type), thunk, type_name(type), ph,
+               us, context + 1, *ph == 'i' ? ",\"s\":\"t\"" : "");
+        first = false;
+    }
+    printf("\n]}\n");
+
+    if (in != stdin) {
+        fclose(in);
+    }
+    return 0;
+}
+
+// *****************************************************************************
+// Private function implementations
+
+static uint64_t get_uint(const unsigned char *p, size_t size, bool swap) {
+    uint64_t value = 0;
+    uint16_t probe = 1;
+    bool little = *(unsigned char *)&probe == 1;
+
+    // Assemble in target byte order, which is host order unless `swap`
+    bool lsb_first = little != swap;
+    for (size_t i = 0; i < size; i++) {
+        size_t k = lsb_first ? size - 1 - i : i;
+        value = (value << 8) | p[k];
+    }
+    return value;
+}
+
+static const char *type_name(unsigned type) {
+    switch (type) {
+    case MU_SCHED_TRACE_NOW:
+        return "now";
+    case MU_SCHED_TRACE_AT:
+        return "at";
+    case MU_SCHED_TRACE_ISR:
+        return "isr";
+    case MU_SCHED_TRACE_REMOTE:
+        return "remote";
+    case MU_SCHED_TRACE_PROMOTE:
+        return "promote";
+    case MU_SCHED_TRACE_RUN_START:
+    case MU_SCHED_TRACE_RUN_END:
+        return "run";
+    case MU_SCHED_TRACE_CANCEL:
+        return "cancel";
+    default:
+        return "unknown";
+    }
+}
+
+static const char *context_name(unsigned context) {
+    switch (context) {
+    case MU_SCHED_TRACE_CTX_SCHED:
+        return "sched";
+    case MU_SCHED_TRACE_CTX_ISR:
+        return "isr";
+    case MU_SCHED_TRACE_CTX_REMOTE:
+        return "remote";
+    default:
+        return "context";
+    }
+}